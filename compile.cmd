@@ -17,11 +17,16 @@ rem compile with GCC in "path"
 g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/pugixml/pugixml.cpp -o obj/inc/pugixml/pugixml.o
 g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/helpers.cpp         -o obj/inc/helpers.o
 g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/elements.cpp        -o obj/inc/elements.o
+g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/batch.cpp           -o obj/inc/batch.o
+g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/fileio.cpp          -o obj/inc/fileio.o
+g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/arena.cpp           -o obj/inc/arena.o
+g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/coords.cpp          -o obj/inc/coords.o
+g++.exe -Wall -std=c++17 -O2 -Iinclude -c inc/uuids.cpp           -o obj/inc/uuids.o
 g++.exe -Wall -std=c++17 -O2 -Iinclude -c main.cpp                -o obj/main.o
 
 
 rem link it all:
-g++.exe -o QET_ElementScaler obj/inc/pugixml/pugixml.o obj/inc/helpers.o obj/inc/elements.o obj/main.o -s
+g++.exe -o QET_ElementScaler obj/inc/pugixml/pugixml.o obj/inc/helpers.o obj/inc/elements.o obj/inc/batch.o obj/inc/fileio.o obj/inc/arena.o obj/inc/coords.o obj/inc/uuids.o obj/main.o -pthread -s
 
 
 @echo off
@@ -15,12 +15,17 @@ echo ""
 echo "--------------------------------------------------------------------------------"
 
 Compiler="g++"
-CompileOptions="-Wall -std=c++17 -O2"
+CompileOptions="-Wall -std=c++17 -O2 -pthread"
 
 # compile
 $Compiler $CompileOptions -c inc/pugixml/pugixml.cpp -o obj/inc/pugixml/pugixml.o
 $Compiler $CompileOptions -c inc/helpers.cpp         -o obj/inc/helpers.o
 $Compiler $CompileOptions -c inc/elements.cpp        -o obj/inc/elements.o
+$Compiler $CompileOptions -c inc/batch.cpp           -o obj/inc/batch.o
+$Compiler $CompileOptions -c inc/fileio.cpp          -o obj/inc/fileio.o
+$Compiler $CompileOptions -c inc/arena.cpp           -o obj/inc/arena.o
+$Compiler $CompileOptions -c inc/coords.cpp          -o obj/inc/coords.o
+$Compiler $CompileOptions -c inc/uuids.cpp           -o obj/inc/uuids.o
 $Compiler $CompileOptions -c main.cpp                -o obj/main.o
 
 # link:
@@ -28,8 +33,13 @@ $Compiler -o QET_ElementScaler \
              obj/inc/pugixml/pugixml.o \
              obj/inc/helpers.o \
              obj/inc/elements.o \
+             obj/inc/batch.o \
+             obj/inc/fileio.o \
+             obj/inc/arena.o \
+             obj/inc/coords.o \
+             obj/inc/uuids.o \
              obj/main.o  \
-          -s
+          -pthread -s
 
 # delete object-files again:
 rm obj/inc/pugixml/*.o  &> /dev/null
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "arena.h"
+
+#include <cstdlib>      // malloc, free
+#include <vector>       // the chunks of an arena
+#include <atomic>       // high-water-mark of all threads
+#include <algorithm>    // std::max
+
+#include "pugixml/pugixml.hpp"
+
+
+
+//
+// every allocation has a small header in front of it: it tells "Deallocate"
+// where the memory comes from. 16 bytes keep the alignment of malloc.
+//
+static const size_t   nHeaderSize = 16;
+static const uint64_t uFromMalloc = 0x4d414c4c4f43ULL;  // "MALLOC"
+static const uint64_t uFromArena  = 0x4152454e41ULL;    // "ARENA"
+static const size_t   nChunkSize  = 1024 * 1024;        // a new chunk has at least 1 MiB
+
+static std::atomic<size_t> nHighWaterMark{0};
+
+
+//
+//--- definition of class "ThreadArena" ----------------------------------------
+//
+// a bump-allocator: the memory is taken from big chunks one after another;
+// the chunks are kept for the next file when the arena is reset
+//
+class ThreadArena {
+    private:
+      struct Chunk {
+          char*  pMem;
+          size_t nSize;
+      };
+      std::vector<Chunk> chunks;
+      size_t iChunk  = 0;  // the chunk we are using
+      size_t nOffset = 0;  // first free byte in this chunk
+      size_t nUsed   = 0;  // bytes used since the last reset
+      //
+    public:
+      bool xActive = false;
+      ~ThreadArena() {
+          for (Chunk& c : chunks)
+              free(c.pMem);
+      }
+      // ---
+      void* Allocate(size_t size) {
+          size = ((size + 15) / 16) * 16;
+          while (iChunk < chunks.size()) {
+              if (nOffset + size <= chunks[iChunk].nSize) {
+                  void* p = chunks[iChunk].pMem + nOffset;
+                  nOffset += size;
+                  nUsed   += size;
+                  return p;
+              }
+              iChunk++;  // does not fit: try the next chunk
+              nOffset = 0;
+          }
+          // all chunks are used: we need another one
+          Chunk c = {nullptr, std::max(size, nChunkSize)};
+          c.pMem = static_cast<char*>(malloc(c.nSize));
+          if (c.pMem == nullptr)
+              return nullptr;
+          chunks.push_back(c);
+          iChunk  = chunks.size() - 1;
+          nOffset = size;
+          nUsed  += size;
+          return c.pMem;
+      }
+      // ---
+      void Reset(void) {
+          size_t nOld = nHighWaterMark.load();
+          while ((nUsed > nOld) && !nHighWaterMark.compare_exchange_weak(nOld, nUsed)) {}
+          iChunk  = 0;
+          nOffset = 0;
+          nUsed   = 0;
+      }
+};
+//
+//--- END - definition of class "ThreadArena" ----------------------------------
+//
+
+static thread_local ThreadArena arena;
+
+
+
+//
+// ###############################################################
+// ###          allocation-functions for pugixml               ###
+// ###############################################################
+//
+static void* Allocate(size_t size) {
+    char* p = nullptr;
+    uint64_t uTag = uFromMalloc;
+    if (arena.xActive) {
+        p = static_cast<char*>(arena.Allocate(size + nHeaderSize));
+        uTag = uFromArena;
+    } else {
+        p = static_cast<char*>(malloc(size + nHeaderSize));
+    }
+    if (p == nullptr)
+        return nullptr;
+    *reinterpret_cast<uint64_t*>(p) = uTag;
+    return p + nHeaderSize;
+}
+// ---
+static void Deallocate(void* ptr) {
+    if (ptr == nullptr)
+        return;
+    char* p = static_cast<char*>(ptr) - nHeaderSize;
+    // memory of the arena is released all at once with the reset
+    if (*reinterpret_cast<uint64_t*>(p) == uFromMalloc)
+        free(p);
+}
+// ---
+void InstallArenaAllocator(void) {
+    pugi::set_memory_management_functions(Allocate, Deallocate);
+}
+// ---
+size_t GetArenaHighWaterMark(void) {
+    return nHighWaterMark.load();
+}
+//
+// ###############################################################
+// ###        END: allocation-functions for pugixml            ###
+// ###############################################################
+//
+
+
+
+//
+//--- implementation of class "ArenaScope" -------------------------------------
+//
+ArenaScope::ArenaScope() {
+    arena.xActive = true;
+}
+// ---
+ArenaScope::~ArenaScope() {
+    arena.xActive = false;
+    arena.Reset();
+}
+//
+//--- END - implementation of class "ArenaScope" -------------------------------
+//
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstdint>      // int8_t, ...
+#include <cstddef>      // size_t
+
+
+//
+// --- function-prototype for installing the arena-allocator for pugixml --------
+//
+// pugixml allocates through these functions from now on: inside an
+// "ArenaScope" from the arena of the thread, everywhere else with malloc
+void InstallArenaAllocator(void);
+
+
+//
+// --- function-prototype for the high-water-mark of the arenas ------------------
+//
+// the most memory one file needed in an arena (all threads) - in bytes
+size_t GetArenaHighWaterMark(void);
+
+
+//
+//--- definition of class "ArenaScope" -----------------------------------------
+//
+// while an ArenaScope lives, pugixml allocates everything of this thread
+// from its arena: "free" does nothing. At the end of the scope the arena
+// is reset in one step and its memory is used again for the next file.
+// Everything allocated inside the scope (the documents!) has to be
+// destroyed before the end of the scope - and in the same thread.
+//
+class ArenaScope {
+    public:
+      ArenaScope();
+      ~ArenaScope();
+      ArenaScope(const ArenaScope&) = delete;
+      ArenaScope& operator=(const ArenaScope&) = delete;
+};
+//
+//--- END - definition of class "ArenaScope" -----------------------------------
+//
+
+
+#endif  //#ifndef ARENA_H
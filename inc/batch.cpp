@@ -0,0 +1,694 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helpers.h"
+#include "batch.h"
+
+#include <fstream>      // for reading the cgroup-files
+#include <sstream>      // for String-Streams
+#include <filesystem>   // for walking through directories
+#include <algorithm>    // for std::sort
+#include <cmath>        // for ceil
+#include <cstdio>       // for reading the files of the cache
+#include <chrono>       // "--watch": waiting for changes
+
+#if defined(__linux__)
+#include <sched.h>      // for sched_getaffinity
+#include <sys/inotify.h>  // "--watch"
+#include <poll.h>       // ... with timeout
+#include <unistd.h>     // ... read, close
+#include <cerrno>
+#include <cstring>      // ... strerror
+#endif // Linux
+
+
+
+//
+// ###############################################################
+// ###      determine the number of usable CPUs (Linux)        ###
+// ###############################################################
+//
+#if defined(__linux__)
+// reads a cgroup-file below "/sys/fs/cgroup" - first in the cgroup of
+// the process, then in the root of the hierarchy (e.g. in containers)
+static bool ReadCgroupFile(const std::string& base, const std::string& path,
+                           const std::string& file, std::string& content) {
+    for (const std::string& dir : {base + path, base}) {
+        std::ifstream in(dir + "/" + file);
+        if (in && std::getline(in, content))
+            return true;
+    }
+    return false;
+}
+// ---
+// returns the CPU-limit of the cgroup (rounded up) or "0" without limit
+static size_t GetCgroupCpuLimit(void) {
+    std::ifstream in("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(in, line)) {
+        // every line: "hierarchy-ID:controller-list:cgroup-path"
+        size_t p1 = line.find(':');
+        size_t p2 = line.find(':', p1 + 1);
+        if ((p1 == std::string::npos) || (p2 == std::string::npos))
+            continue;
+        std::string controllers = line.substr(p1 + 1, p2 - p1 - 1);
+        std::string path        = line.substr(p2 + 1);
+        std::string content;
+        if (controllers.empty()) {
+            // cgroup v2: "cpu.max" contains "$MAX $PERIOD" or "max $PERIOD"
+            if (ReadCgroupFile("/sys/fs/cgroup", path, "cpu.max", content)) {
+                std::stringstream ss(content);
+                std::string quota;
+                double period = 0.0;
+                ss >> quota >> period;
+                if ((quota != "max") && (period > 0.0))
+                    return (size_t)std::max(1.0, std::ceil(std::stod(quota) / period));
+            }
+        } else if ((("," + controllers + ",").find(",cpu,") != std::string::npos)) {
+            // cgroup v1: quota and period in separate files, "-1" is "no limit"
+            std::string sQuota, sPeriod;
+            for (const std::string base : {"/sys/fs/cgroup/cpu,cpuacct", "/sys/fs/cgroup/cpu"}) {
+                if (ReadCgroupFile(base, path, "cpu.cfs_quota_us", sQuota) &&
+                    ReadCgroupFile(base, path, "cpu.cfs_period_us", sPeriod)) {
+                    double quota  = std::stod(sQuota);
+                    double period = std::stod(sPeriod);
+                    if ((quota > 0.0) && (period > 0.0))
+                        return (size_t)std::max(1.0, std::ceil(quota / period));
+                    break;
+                }
+            }
+        }
+    }
+    return 0;
+}
+#endif // Linux
+// ---
+size_t GetDefaultJobCount(void) {
+    size_t n = std::thread::hardware_concurrency();
+#if defined(__linux__)
+    // the affinity-mask may be smaller than the number of cores (taskset, ...)
+    cpu_set_t cs;
+    CPU_ZERO(&cs);
+    if (sched_getaffinity(0, sizeof(cs), &cs) == 0) {
+        size_t nAffinity = (size_t)CPU_COUNT(&cs);
+        if (nAffinity > 0) n = nAffinity;
+    }
+    // a CPU-quota of the cgroup (docker, systemd, ...) limits it further
+    try {
+        size_t nQuota = GetCgroupCpuLimit();
+        if ((nQuota > 0) && (nQuota < n)) n = nQuota;
+    } catch (...) {
+        // invalid content of cgroup-files: ignore the quota
+    }
+#endif // Linux
+    if (_DEBUG_) std::cerr << "default number of jobs: " << n << "\n";
+    return std::max(n, (size_t)1);
+}
+//
+// ###############################################################
+// ###    END: determine the number of usable CPUs (Linux)     ###
+// ###############################################################
+//
+
+
+
+//
+// ###############################################################
+// ###       collect all element-files in a directory          ###
+// ###############################################################
+//
+// "*.elmt" - but not our own results ("*.SCALED.elmt"): they are not scaled again
+static bool IsElementFile(const std::string& s) {
+    const std::string sExt    = ".elmt";
+    const std::string sScaled = ".SCALED.elmt";
+    if ((s.length() <= sExt.length()) ||
+        (s.compare(s.length() - sExt.length(), sExt.length(), sExt) != 0))
+        return false;
+    return !((s.length() > sScaled.length()) &&
+             (s.compare(s.length() - sScaled.length(), sScaled.length(), sScaled) == 0));
+}
+// ---
+std::vector<std::string> FindElementFiles(const std::string& dir) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && (it != fs::recursive_directory_iterator()); it.increment(ec)) {
+        if (!it->is_regular_file(ec))
+            continue;
+        const std::string s = it->path().string();
+        if (IsElementFile(s))
+            files.push_back(s);
+    }
+    if (ec)
+        std::cerr << "error while reading directory \"" << dir << "\": " << ec.message() << "\n";
+    // a defined order makes the results reproducible:
+    std::sort(files.begin(), files.end());
+    return files;
+}
+//
+// ###############################################################
+// ###     END: collect all element-files in a directory       ###
+// ###############################################################
+//
+
+
+
+//
+// ###############################################################
+// ###          read the UUID of an element-file               ###
+// ###############################################################
+//
+std::string ReadElementUUID(const std::string& sFile) {
+    std::string s;
+    FILE* f = fopen(sFile.c_str(), "rb");
+    if (f == nullptr)
+        return "";
+    char buf[65536];
+    size_t n = 0;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        s.append(buf, n);
+    fclose(f);
+    auto IsSpace = [](const char c) { return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'); };
+    // the tag "<uuid ...>" - not "<uuids>" or the like
+    for (size_t pos = s.find("<uuid"); pos != std::string::npos; pos = s.find("<uuid", pos)) {
+        pos += 5;
+        if ((pos >= s.length()) || !IsSpace(s[pos]))
+            continue;
+        const size_t end = s.find('>', pos);
+        if (end == std::string::npos)
+            break;
+        // its attribute "uuid = '...'" or "uuid = \"...\""
+        for (size_t a = s.find("uuid", pos); (a != std::string::npos) && (a < end); a = s.find("uuid", a + 4)) {
+            if (!IsSpace(s[a - 1]))
+                continue;
+            size_t i = a + 4;
+            while ((i < end) && IsSpace(s[i])) i++;
+            if ((i >= end) || (s[i] != '='))
+                continue;
+            i++;
+            while ((i < end) && IsSpace(s[i])) i++;
+            if ((i >= end) || ((s[i] != '"') && (s[i] != '\'')))
+                continue;
+            const size_t q = s.find(s[i], i + 1);
+            if ((q == std::string::npos) || (q > end))
+                break;
+            return s.substr(i + 1, q - i - 1);
+        }
+        return "";
+    }
+    return "";
+}
+//
+// ###############################################################
+// ###        END: read the UUID of an element-file            ###
+// ###############################################################
+//
+
+
+
+//
+// ###############################################################
+// ###              sort files by size: largest first          ###
+// ###############################################################
+//
+void SortLargestFirst(std::vector<std::string>& files) {
+    std::vector<std::pair<uintmax_t, std::string>> sized;
+    sized.reserve(files.size());
+    for (auto& f : files) {
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(f, ec);
+        sized.emplace_back((ec ? 0 : size), std::move(f));
+    }
+    // "stable": files with the same size remain in alphabetical order
+    std::stable_sort(sized.begin(), sized.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t i = 0; i < files.size(); i++)
+        files[i] = std::move(sized[i].second);
+}
+//
+// ###############################################################
+// ###          END: sort files by size: largest first         ###
+// ###############################################################
+//
+
+
+
+//
+//--- implementation of class "ThreadPool" -------------------------------------
+//
+ThreadPool::ThreadPool(size_t numThreads) {
+    numThreads = std::max(numThreads, (size_t)1);
+    for (size_t i = 0; i < numThreads; i++)
+        queues.push_back(std::make_unique<WorkQueue>());
+    for (size_t i = 0; i < numThreads; i++)
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+// ---
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    cvTask.notify_all();
+    for (auto& t : workers)
+        t.join();
+}
+// ---
+void ThreadPool::Submit(std::function<void()> task) {
+    WorkQueue& q = *queues[nextQueue++ % queues.size()];
+    {
+        std::lock_guard<std::mutex> lock(q.mtx);
+        q.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        queued++;
+        pending++;
+    }
+    cvTask.notify_one();
+}
+// ---
+void ThreadPool::Wait(void) {
+    std::unique_lock<std::mutex> lock(mtx);
+    cvDone.wait(lock, [this] { return (pending == 0); });
+}
+// ---
+bool ThreadPool::PopTask(const size_t self, std::function<void()>& task) {
+    // own deque first: from the front
+    {
+        WorkQueue& q = *queues[self];
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    // nothing to do? steal from the back of the other workers:
+    for (size_t i = 1; i < queues.size(); i++) {
+        WorkQueue& q = *queues[(self + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+// ---
+void ThreadPool::WorkerLoop(const size_t self) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cvTask.wait(lock, [this] { return stop || (queued > 0); });
+            if (queued == 0)
+                return;  // stop and nothing left to do
+            queued--;    // one of the queued tasks is reserved for this worker
+        }
+        // the reserved task is in one of the deques - go and get it:
+        std::function<void()> task;
+        while (!PopTask(self, task))
+            std::this_thread::yield();
+        task();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            pending--;
+            if (pending == 0)
+                cvDone.notify_all();
+        }
+    }
+}
+//
+//--- END - implementation of class "ThreadPool" -------------------------------
+//
+
+
+
+
+//
+//--- implementation of class "BatchCache" -------------------------------------
+//
+static uint64_t FNV1a(const void* data, const size_t len, uint64_t h = 0xCBF29CE484222325ull) {
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ p[i]) * 0x100000001B3ull;
+    return h;
+}
+// ---
+static bool HashFile(const std::string& sFile, uint64_t& hash) {
+    FILE* f = fopen(sFile.c_str(), "rb");
+    if (f == nullptr)
+        return false;
+    char buf[64 * 1024];
+    uint64_t h = 0xCBF29CE484222325ull;
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        h = FNV1a(buf, n, h);
+    const bool xOK = (ferror(f) == 0);
+    fclose(f);
+    hash = h;
+    return xOK;
+}
+// ---
+BatchCache::BatchCache(const std::string& sOptions, const std::string& sVer) : sVersion(sVer) {
+    const std::string s = sOptions + "|" + sVersion;
+    fingerprint = FNV1a(s.data(), s.length());
+}
+// ---
+// the first line of a cache-file
+static std::string CacheHeader(const std::string& sVersion) {
+    return "# QET_ElementScaler " + sVersion + ": hash size mtime options uuid name";
+}
+// ---
+// one line per file: "HASH SIZE MTIME FINGERPRINT UUID NAME" (hex, dec, dec,
+// hex, "-" for none, rest of the line); the cache of another version is ignored
+BatchCache::DirCache& BatchCache::GetDir(const std::string& dir) {
+    auto it = dirs.find(dir);
+    if (it != dirs.end())
+        return it->second;
+    DirCache& dc = dirs[dir];
+    std::ifstream in((std::filesystem::path(dir) / sFileName).string());
+    std::string sLine;
+    if (!std::getline(in, sLine) || (sLine != CacheHeader(sVersion)))
+        return dc;
+    while (std::getline(in, sLine)) {
+        if ((sLine.length() == 0) || (sLine[0] == '#'))
+            continue;
+        std::istringstream ss(sLine);
+        Entry e;
+        std::string sName;
+        ss >> std::hex >> e.hash >> std::dec >> e.size >> e.mtime >> std::hex >> e.fingerprint >> e.uuid;
+        if (!ss) continue;
+        if (e.uuid == "-") e.uuid = "";
+        ss.get();  // the blank in front of the name
+        std::getline(ss, sName);
+        if (sName.length() > 0)
+            dc.entries[sName] = e;
+    }
+    return dc;
+}
+// ---
+bool BatchCache::IsUpToDate(const std::string& sFile, const std::string& sOutFile, std::string& sUuid) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    sUuid = "";
+    const fs::path path(sFile);
+    Entry now;
+    now.size = (uint64_t)fs::file_size(path, ec);
+    if (ec) return false;
+    now.mtime = (int64_t)fs::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) return false;
+    now.fingerprint = fingerprint;
+    const std::string sDir  = path.parent_path().string();
+    const std::string sName = path.filename().string();
+    const bool xOutput = ((sOutFile.length() > 0) && fs::exists(sOutFile, ec));
+
+    Entry old;
+    bool xKnown = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        DirCache& dc = GetDir(sDir);
+        auto it = dc.entries.find(sName);
+        if (it != dc.entries.end()) { old = it->second; xKnown = true; }
+    }
+    const bool xSameOptions = xKnown && (old.fingerprint == fingerprint);
+    // the quick way: same size and time - no need to read the file
+    if (xOutput && xSameOptions && (old.size == now.size) && (old.mtime == now.mtime)) {
+        sUuid = old.uuid;
+        return true;
+    }
+    if (HashFile(sFile, now.hash) == false)
+        return false;
+    if (xOutput && xSameOptions && (old.size == now.size) && (old.hash == now.hash)) {
+        // only "touched": the content is the same
+        now.uuid = sUuid = old.uuid;
+        std::lock_guard<std::mutex> lock(mtx);
+        DirCache& dc = GetDir(sDir);
+        dc.entries[sName] = now;
+        dc.xChanged = true;
+        return true;
+    }
+    now.uuid = sUuid = ReadElementUUID(sFile);
+    std::lock_guard<std::mutex> lock(mtx);
+    pending[sFile] = now;
+    return false;
+}
+// ---
+void BatchCache::Done(const std::string& sFile) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = pending.find(sFile);
+    if (it == pending.end())
+        return;
+    const std::filesystem::path path(sFile);
+    DirCache& dc = GetDir(path.parent_path().string());
+    dc.entries[path.filename().string()] = it->second;
+    dc.xChanged = true;
+    pending.erase(it);
+}
+// ---
+bool BatchCache::Save(void) {
+    std::lock_guard<std::mutex> lock(mtx);
+    bool xOK = true;
+    for (auto& d : dirs) {
+        if (d.second.xChanged == false)
+            continue;
+        // first into a temporary file: an interrupted run leaves the old cache
+        const std::string sCache = (std::filesystem::path(d.first) / sFileName).string();
+        const std::string sTemp  = sCache + ".tmp";
+        FILE* f = fopen(sTemp.c_str(), "w");
+        if (f == nullptr) {
+            std::cerr << "cache \"" << sCache << "\" could not be saved!\n";
+            xOK = false;
+            continue;
+        }
+        fprintf(f, "%s\n", CacheHeader(sVersion).c_str());
+        for (const auto& e : d.second.entries) {
+            // a UUID with blanks would break the line: then it is read again next time
+            const std::string& u = e.second.uuid;
+            const bool xBlanks = (u.find_first_of(" \t\r\n") != std::string::npos);
+            fprintf(f, "%016llx %llu %lld %016llx %s %s\n", (unsigned long long)e.second.hash,
+                    (unsigned long long)e.second.size, (long long)e.second.mtime,
+                    (unsigned long long)(xBlanks ? 0 : e.second.fingerprint),
+                    ((u.empty() || xBlanks) ? "-" : u.c_str()), e.first.c_str());
+        }
+        const bool xWritten = (ferror(f) == 0);
+        if ((fclose(f) != 0) || !xWritten) {
+            std::cerr << "cache \"" << sCache << "\" could not be saved!\n";
+            std::remove(sTemp.c_str());
+            xOK = false;
+            continue;
+        }
+        std::error_code ec;
+        std::filesystem::rename(sTemp, sCache, ec);
+        if (ec) {
+            std::cerr << "cache \"" << sCache << "\" could not be saved: " << ec.message() << "\n";
+            xOK = false;
+            continue;
+        }
+        d.second.xChanged = false;
+    }
+    return xOK;
+}
+//
+//--- END - implementation of class "BatchCache" -------------------------------
+//
+
+
+
+
+//
+//--- implementation of class "DirWatcher" -------------------------------------
+//
+DirWatcher::DirWatcher(const std::string& dir) : sRoot(dir)
+{
+#if defined(__linux__)
+    fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0) {
+        sError = std::string("inotify: ") + strerror(errno);
+        return;
+    }
+    AddTree(sRoot, nullptr);
+#else
+    std::vector<std::string> files;
+    Scan(files);  // only the modification-times
+#endif
+}
+// ---
+DirWatcher::~DirWatcher()
+{
+#if defined(__linux__)
+    if (fd >= 0)
+        close(fd);
+#endif
+}
+// ---
+// watches "dir" and all its sub-directories; "pFound" gets the element-files
+// already in there (a directory copied or moved into the tree)
+void DirWatcher::AddTree(const std::string& dir, std::vector<std::string>* pFound)
+{
+#if defined(__linux__)
+    namespace fs = std::filesystem;
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MOVE_SELF | IN_ONLYDIR;
+    std::vector<std::string> vsDirs = { dir };
+    std::error_code ec;
+    fs::recursive_directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && (it != fs::recursive_directory_iterator()); it.increment(ec)) {
+        if (it->is_directory(ec))
+            vsDirs.push_back(it->path().string());
+        else if ((pFound != nullptr) && IsElementFile(it->path().string()))
+            pFound->push_back(it->path().string());
+    }
+    for (const std::string& d : vsDirs) {
+        const int wd = inotify_add_watch(fd, d.c_str(), mask);
+        if (wd < 0) {
+            // ENOSPC: "/proc/sys/fs/inotify/max_user_watches" is too small
+            std::cerr << "directory \"" << d << "\" can not be watched: " << strerror(errno) << "\n";
+            continue;
+        }
+        dirs[wd] = d;
+    }
+#else
+    (void)dir;
+    (void)pFound;
+#endif
+}
+// ---
+void DirWatcher::ReadEvents(std::vector<std::string>& files)
+{
+#if defined(__linux__)
+    alignas(struct inotify_event) char buf[16384];
+    const ssize_t len = read(fd, buf, sizeof(buf));
+    if (len < 0) {
+        if ((errno != EINTR) && (errno != EAGAIN))
+            sError = std::string("inotify: ") + strerror(errno);
+        return;
+    }
+    for (char* p = buf; p < buf + len; ) {
+        const struct inotify_event* ev = reinterpret_cast<const struct inotify_event*>(p);
+        p += sizeof(struct inotify_event) + ev->len;
+        if (ev->mask & IN_Q_OVERFLOW) {
+            // events were lost: everything could have changed
+            const std::vector<std::string> all = FindElementFiles(sRoot);
+            files.insert(files.end(), all.begin(), all.end());
+            continue;
+        }
+        const auto itDir = dirs.find(ev->wd);
+        if (itDir == dirs.end())
+            continue;
+        if (ev->mask & IN_IGNORED) {  // directory deleted or watch removed
+            dirs.erase(itDir);
+            continue;
+        }
+        if (ev->mask & IN_MOVE_SELF) {
+            // moved away: the path is wrong now - moved back, it is added again
+            if (itDir->second != sRoot)
+                inotify_rm_watch(fd, ev->wd);
+            continue;
+        }
+        if (ev->len == 0)
+            continue;
+        const std::string sPath = (std::filesystem::path(itDir->second) / ev->name).string();
+        if (ev->mask & IN_ISDIR) {
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+                AddTree(sPath, &files);
+        } else if ((ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && IsElementFile(sPath)) {
+            files.push_back(sPath);
+        }
+    }
+#else
+    (void)files;
+#endif
+}
+// ---
+// polling: new files and files with another modification-time
+void DirWatcher::Scan(std::vector<std::string>& files)
+{
+    for (const std::string& sFile : FindElementFiles(sRoot)) {
+        std::error_code ec;
+        const auto t = std::filesystem::last_write_time(sFile, ec);
+        if (ec)
+            continue;
+        const int64_t mtime = (int64_t)t.time_since_epoch().count();
+        auto itFile = mtimes.find(sFile);
+        if (itFile == mtimes.end()) {
+            mtimes.emplace(sFile, mtime);
+        } else if (itFile->second != mtime) {
+            itFile->second = mtime;
+        } else {
+            continue;
+        }
+        files.push_back(sFile);
+    }
+}
+// ---
+std::vector<std::string> DirWatcher::Wait(const int msQuiet)
+{
+    std::vector<std::string> files;
+#if defined(__linux__)
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    int timeout = -1;  // wait for the first event without limit
+    while (IsOK()) {
+        const int r = poll(&pfd, 1, timeout);
+        if (r < 0) {
+            if (errno != EINTR)
+                sError = std::string("poll: ") + strerror(errno);
+            continue;
+        }
+        if (r == 0)
+            break;  // quiet for "msQuiet" ms
+        ReadEvents(files);
+        if (!files.empty())
+            timeout = msQuiet;
+    }
+#else
+    // a full scan every second - and once more after "msQuiet"
+    while (files.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        Scan(files);
+    }
+    for (size_t n = 0; n != files.size(); ) {
+        n = files.size();
+        std::this_thread::sleep_for(std::chrono::milliseconds(msQuiet));
+        Scan(files);
+    }
+#endif
+    // deleted meanwhile (e.g. temporary files of an editor): nothing to do
+    files.erase(std::remove_if(files.begin(), files.end(), [](const std::string& f) {
+                    std::error_code ec;
+                    return !std::filesystem::is_regular_file(f, ec);
+                }), files.end());
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
+//
+//--- END - implementation of class "DirWatcher" -------------------------------
+//
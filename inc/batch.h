@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstdint>      // int8_t, ...
+#include <string>       // we handle strings here
+#include <vector>       // list of files
+#include <deque>        // queue of tasks
+#include <functional>   // std::function for tasks
+#include <memory>       // std::unique_ptr for the queues
+#include <atomic>       // distribution of tasks
+#include <thread>       // worker-threads
+#include <mutex>        // protect the task-queues
+#include <condition_variable>
+#include <algorithm>    // std::max
+#include <unordered_map>  // entries of the cache
+
+
+//
+// --- function-prototype for the default number of worker-threads -------------
+//
+// respects the CPU-affinity-mask of the process and a CPU-quota of the
+// cgroup (Linux) - not only the number of cores of the host
+size_t GetDefaultJobCount(void);
+
+
+//
+// --- function-prototype for collecting all element-files in a directory ------
+//
+// walks recursively through "dir" and returns all "*.elmt"-files;
+// already scaled files ("*.SCALED.elmt") are skipped
+std::vector<std::string> FindElementFiles(const std::string& dir);
+
+
+//
+// --- function-prototype for reading the UUID of an element-file --------------
+//
+// the value of "<uuid uuid="..."/>" without parsing the whole document;
+// empty, if the file has no element-UUID or can not be read
+std::string ReadElementUUID(const std::string& sFile);
+
+
+//
+// --- function-prototype for sorting files by size ----------------------------
+//
+// the largest files first: big elements should not be started at the end
+// of a batch-run when the other threads are already idle
+void SortLargestFirst(std::vector<std::string>& files);
+
+
+//
+//--- definition of class "ThreadPool" -----------------------------------------
+//
+// every worker has its own deque of tasks: new tasks are distributed
+// round-robin, a worker takes its tasks from the front of its own deque
+// (in submit-order) and an idle worker steals from the back of the
+// deques of the other workers
+//
+class ThreadPool {
+    private:
+      struct WorkQueue {
+          std::mutex mtx;
+          std::deque<std::function<void()>> tasks;
+      };
+      std::vector<std::unique_ptr<WorkQueue>> queues;
+      std::vector<std::thread> workers;
+      std::atomic<size_t> nextQueue{0};  // round-robin for "Submit"
+      std::mutex mtx;                    // protects the counters below
+      std::condition_variable cvTask;    // new task or stop
+      std::condition_variable cvDone;    // all tasks done
+      size_t queued  = 0;                // tasks in queues, not yet reserved
+      size_t pending = 0;                // tasks submitted but not finished
+      bool stop = false;
+      bool PopTask(const size_t, std::function<void()>&);
+      void WorkerLoop(const size_t);
+      //
+    public:
+      explicit ThreadPool(size_t numThreads);
+      ~ThreadPool();
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+      void Submit(std::function<void()> task);
+      void Wait(void);  // blocks until all submitted tasks are done
+      size_t Size(void) const { return workers.size(); }
+};
+//
+//--- END - definition of class "ThreadPool" -----------------------------------
+//
+
+
+
+//
+//--- definition of class "BoundedQueue" ---------------------------------------
+//
+// connects two stages of a pipeline: "Push" blocks while the queue is full,
+// "Pop" blocks while it is empty and returns "false" when the queue was
+// closed by the producer(s) and nothing is left
+//
+template <typename T>
+class BoundedQueue {
+    private:
+      std::deque<T> items;
+      size_t capacity;
+      bool closed = false;
+      std::mutex mtx;
+      std::condition_variable cvNotFull;
+      std::condition_variable cvNotEmpty;
+      // statistics:
+      uint64_t nPush    = 0;  // number of items
+      uint64_t nFull    = 0;  // "Push" had to wait: the consumer is too slow
+      uint64_t nEmpty   = 0;  // "Pop" had to wait: the producer is too slow
+      uint64_t sumFill  = 0;  // sum of fill-levels at "Push"
+      //
+    public:
+      explicit BoundedQueue(size_t cap) : capacity(std::max(cap, (size_t)1)) {}
+      BoundedQueue(const BoundedQueue&) = delete;
+      BoundedQueue& operator=(const BoundedQueue&) = delete;
+      // ---
+      void Push(T item) {
+          std::unique_lock<std::mutex> lock(mtx);
+          if (items.size() >= capacity) nFull++;
+          cvNotFull.wait(lock, [this] { return (items.size() < capacity); });
+          sumFill += items.size();
+          nPush++;
+          items.push_back(std::move(item));
+          lock.unlock();
+          cvNotEmpty.notify_one();
+      }
+      // ---
+      bool Pop(T& item) {
+          std::unique_lock<std::mutex> lock(mtx);
+          if (items.empty() && !closed) nEmpty++;
+          cvNotEmpty.wait(lock, [this] { return (!items.empty() || closed); });
+          if (items.empty())
+              return false;  // closed and nothing left
+          item = std::move(items.front());
+          items.pop_front();
+          lock.unlock();
+          cvNotFull.notify_one();
+          return true;
+      }
+      // ---
+      void Close(void) {
+          {
+              std::lock_guard<std::mutex> lock(mtx);
+              closed = true;
+          }
+          cvNotEmpty.notify_all();
+      }
+      // ---
+      size_t   Capacity(void)  const { return capacity; }
+      uint64_t Pushed(void)    const { return nPush; }
+      uint64_t WaitFull(void)  const { return nFull; }
+      uint64_t WaitEmpty(void) const { return nEmpty; }
+      double   AverageFill(void) const { return (nPush > 0) ? ((double)sumFill / (double)nPush) : 0.0; }
+};
+//
+//--- END - definition of class "BoundedQueue" ---------------------------------
+//
+
+
+
+//
+//--- definition of class "BatchCache" -----------------------------------------
+//
+// "--cache": every directory with element-files gets a file ".QET_ElementScaler.cache"
+// with one line per input-file: hash of the content, size, modification-time
+// the fingerprint of the options (including the version of the program) and
+// the element-UUID, so skipped files still take part in the duplicate-check;
+// an input with unchanged content and options is skipped - if its output
+// still exists - without being parsed
+//
+class BatchCache {
+    private:
+      struct Entry {
+          uint64_t hash        = 0;  // FNV-1a of the content
+          uint64_t size        = 0;
+          int64_t  mtime       = 0;
+          uint64_t fingerprint = 0;  // options and version
+          std::string uuid     = "";  // element-UUID of the input
+      };
+      struct DirCache {
+          std::unordered_map<std::string, Entry> entries;  // file-name -> entry
+          bool xChanged = false;
+      };
+      std::mutex mtx;
+      std::unordered_map<std::string, DirCache> dirs;   // directory -> its cache
+      std::unordered_map<std::string, Entry> pending;   // path -> entry, until the output is written
+      uint64_t fingerprint;
+      std::string sVersion;
+      DirCache& GetDir(const std::string& dir);         // reads the cache-file (locked!)
+      //
+    public:
+      static constexpr const char* sFileName = ".QET_ElementScaler.cache";
+      BatchCache(const std::string& sOptions, const std::string& sVersion);
+      BatchCache(const BatchCache&) = delete;
+      BatchCache& operator=(const BatchCache&) = delete;
+      // "true": input and options are unchanged and "sOutFile" exists;
+      // "sUuid": the element-UUID of the input (of an unchanged file from the cache)
+      bool IsUpToDate(const std::string& sFile, const std::string& sOutFile, std::string& sUuid);
+      // the output of "sFile" was written: remember the input
+      void Done(const std::string& sFile);
+      // writes the changed cache-files; "false" on error
+      bool Save(void);
+};
+//
+//--- END - definition of class "BatchCache" -----------------------------------
+//
+
+
+
+//
+//--- definition of class "DirWatcher" -----------------------------------------
+//
+// "--watch": reports the element-files of a directory-tree, that were
+// written, moved or copied into it; on Linux with inotify (new directories
+// are watched too), everywhere else by polling the modification-times
+//
+class DirWatcher {
+    private:
+      std::string sRoot;
+      std::string sError = "";
+      int fd = -1;                                     // inotify
+      std::unordered_map<int, std::string> dirs;       // watch-descriptor -> directory
+      std::unordered_map<std::string, int64_t> mtimes; // polling: file -> modification-time
+      void AddTree(const std::string& dir, std::vector<std::string>* pFound);
+      void ReadEvents(std::vector<std::string>& files);
+      void Scan(std::vector<std::string>& files);
+      //
+    public:
+      explicit DirWatcher(const std::string& dir);
+      ~DirWatcher();
+      DirWatcher(const DirWatcher&) = delete;
+      DirWatcher& operator=(const DirWatcher&) = delete;
+      // blocks until element-files changed and then "msQuiet" milliseconds
+      // passed without a further change (a burst of saves is processed
+      // once); returns the changed files sorted and without duplicates
+      std::vector<std::string> Wait(const int msQuiet);
+      bool IsOK(void) const { return sError.empty(); }
+      const std::string& Error(void) const { return sError; }
+};
+//
+//--- END - definition of class "DirWatcher" -----------------------------------
+//
+
+
+#endif  //#ifndef BATCH_H
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "coords.h"
+
+#include <algorithm>    // for std::min, std::max
+
+// AVX2 and SSE2 only with GCC/Clang on x86 - everything else uses plain C++
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define COORDS_X86
+#include <immintrin.h>
+#endif
+
+
+
+//
+// ###############################################################
+// ###                  scalar kernels                         ###
+// ###############################################################
+//
+// one coordinate: "p * u + q * w" - like "AffineTransform::Apply" without
+// the zero-entries, so the results are the same up to the last bit
+enum Mode : int { OnlyU = 0, OnlyW = 1, Both = 2 };
+static int GetMode(const double p, const double q) {
+    if (q == 0.0) return OnlyU;
+    if (p == 0.0) return OnlyW;
+    return Both;
+}
+// ---
+static inline double Combine(const int mode, const double p, const double u,
+                             const double q, const double w) {
+    switch (mode) {
+        case OnlyU: return p * u;
+        case OnlyW: return q * w;
+        default:    return p * u + q * w;
+    }
+}
+// ---
+static void TransformScalar(const double (&m)[6], double* x, double* y,
+                            const size_t iStart, const size_t n) {
+    const int mx = GetMode(m[0], m[1]);
+    const int my = GetMode(m[3], m[2]);
+    for (size_t i = iStart; i < n; i++) {
+        const double nx = Combine(mx, m[0], x[i], m[1], y[i]);
+        const double ny = Combine(my, m[3], y[i], m[2], x[i]);
+        x[i] = (m[4] == 0.0) ? nx : (nx + m[4]);
+        y[i] = (m[5] == 0.0) ? ny : (ny + m[5]);
+    }
+}
+// ---
+static void MinMaxScalar(const double* v, const size_t iStart, const size_t n,
+                         double& vMin, double& vMax) {
+    for (size_t i = iStart; i < n; i++) {
+        vMin = std::min(vMin, v[i]);
+        vMax = std::max(vMax, v[i]);
+    }
+}
+#if !defined(COORDS_X86)
+// ---
+static void TransformPlain(const double (&m)[6], double* x, double* y, const size_t n) {
+    TransformScalar(m, x, y, 0, n);
+}
+// ---
+static void MinMaxPlain(const double* v, const size_t n, double& vMin, double& vMax) {
+    MinMaxScalar(v, 0, n, vMin, vMax);
+}
+#endif // !COORDS_X86
+//
+// ###############################################################
+// ###                END: scalar kernels                      ###
+// ###############################################################
+//
+
+
+
+#if defined(COORDS_X86)
+//
+// ###############################################################
+// ###              SSE2 kernels: 2 values at once             ###
+// ###############################################################
+//
+static inline __m128d Combine128(const int mode, const __m128d p, const __m128d u,
+                                 const __m128d q, const __m128d w) {
+    switch (mode) {
+        case OnlyU: return _mm_mul_pd(p, u);
+        case OnlyW: return _mm_mul_pd(q, w);
+        default:    return _mm_add_pd(_mm_mul_pd(p, u), _mm_mul_pd(q, w));
+    }
+}
+// ---
+static void TransformSSE2(const double (&m)[6], double* x, double* y, const size_t n) {
+    const int mx = GetMode(m[0], m[1]);
+    const int my = GetMode(m[3], m[2]);
+    const bool xAddE = (m[4] != 0.0);
+    const bool xAddF = (m[5] != 0.0);
+    const __m128d a = _mm_set1_pd(m[0]), b = _mm_set1_pd(m[1]);
+    const __m128d c = _mm_set1_pd(m[2]), d = _mm_set1_pd(m[3]);
+    const __m128d e = _mm_set1_pd(m[4]), f = _mm_set1_pd(m[5]);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d vx = _mm_loadu_pd(x + i);
+        const __m128d vy = _mm_loadu_pd(y + i);
+        __m128d nx = Combine128(mx, a, vx, b, vy);
+        __m128d ny = Combine128(my, d, vy, c, vx);
+        if (xAddE) nx = _mm_add_pd(nx, e);
+        if (xAddF) ny = _mm_add_pd(ny, f);
+        _mm_storeu_pd(x + i, nx);
+        _mm_storeu_pd(y + i, ny);
+    }
+    TransformScalar(m, x, y, i, n);
+}
+// ---
+static void MinMaxSSE2(const double* v, const size_t n, double& vMin, double& vMax) {
+    size_t i = 0;
+    if (n >= 2) {
+        __m128d lo = _mm_set1_pd(vMin);
+        __m128d hi = _mm_set1_pd(vMax);
+        for (; i + 2 <= n; i += 2) {
+            const __m128d val = _mm_loadu_pd(v + i);
+            lo = _mm_min_pd(lo, val);
+            hi = _mm_max_pd(hi, val);
+        }
+        double tmp[2];
+        _mm_storeu_pd(tmp, lo);
+        vMin = std::min(tmp[0], tmp[1]);
+        _mm_storeu_pd(tmp, hi);
+        vMax = std::max(tmp[0], tmp[1]);
+    }
+    MinMaxScalar(v, i, n, vMin, vMax);
+}
+//
+// ###############################################################
+// ###            END: SSE2 kernels: 2 values at once          ###
+// ###############################################################
+//
+
+
+
+//
+// ###############################################################
+// ###              AVX2 kernels: 4 values at once             ###
+// ###############################################################
+//
+// compiled for AVX2 independent of the compile-options - but only
+// called, when the CPU supports it (see "SelectKernels")
+__attribute__((target("avx2")))
+static inline __m256d Combine256(const int mode, const __m256d p, const __m256d u,
+                                 const __m256d q, const __m256d w) {
+    switch (mode) {
+        case OnlyU: return _mm256_mul_pd(p, u);
+        case OnlyW: return _mm256_mul_pd(q, w);
+        default:    return _mm256_add_pd(_mm256_mul_pd(p, u), _mm256_mul_pd(q, w));
+    }
+}
+// ---
+__attribute__((target("avx2")))
+static void TransformAVX2(const double (&m)[6], double* x, double* y, const size_t n) {
+    const int mx = GetMode(m[0], m[1]);
+    const int my = GetMode(m[3], m[2]);
+    const bool xAddE = (m[4] != 0.0);
+    const bool xAddF = (m[5] != 0.0);
+    const __m256d a = _mm256_set1_pd(m[0]), b = _mm256_set1_pd(m[1]);
+    const __m256d c = _mm256_set1_pd(m[2]), d = _mm256_set1_pd(m[3]);
+    const __m256d e = _mm256_set1_pd(m[4]), f = _mm256_set1_pd(m[5]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d vx = _mm256_loadu_pd(x + i);
+        const __m256d vy = _mm256_loadu_pd(y + i);
+        __m256d nx = Combine256(mx, a, vx, b, vy);
+        __m256d ny = Combine256(my, d, vy, c, vx);
+        if (xAddE) nx = _mm256_add_pd(nx, e);
+        if (xAddF) ny = _mm256_add_pd(ny, f);
+        _mm256_storeu_pd(x + i, nx);
+        _mm256_storeu_pd(y + i, ny);
+    }
+    TransformScalar(m, x, y, i, n);
+}
+// ---
+__attribute__((target("avx2")))
+static void MinMaxAVX2(const double* v, const size_t n, double& vMin, double& vMax) {
+    size_t i = 0;
+    if (n >= 4) {
+        __m256d lo = _mm256_set1_pd(vMin);
+        __m256d hi = _mm256_set1_pd(vMax);
+        for (; i + 4 <= n; i += 4) {
+            const __m256d val = _mm256_loadu_pd(v + i);
+            lo = _mm256_min_pd(lo, val);
+            hi = _mm256_max_pd(hi, val);
+        }
+        double tmp[4];
+        _mm256_storeu_pd(tmp, lo);
+        vMin = std::min(std::min(tmp[0], tmp[1]), std::min(tmp[2], tmp[3]));
+        _mm256_storeu_pd(tmp, hi);
+        vMax = std::max(std::max(tmp[0], tmp[1]), std::max(tmp[2], tmp[3]));
+    }
+    MinMaxScalar(v, i, n, vMin, vMax);
+}
+//
+// ###############################################################
+// ###            END: AVX2 kernels: 4 values at once          ###
+// ###############################################################
+//
+#endif // COORDS_X86
+
+
+
+//
+// ###############################################################
+// ###          choose the kernels once for the CPU            ###
+// ###############################################################
+//
+struct CoordKernels {
+    void (*transform)(const double (&)[6], double*, double*, const size_t);
+    void (*minmax)(const double*, const size_t, double&, double&);
+    const char* name;
+};
+// ---
+static CoordKernels SelectKernels(void) {
+#if defined(COORDS_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return { TransformAVX2, MinMaxAVX2, "AVX2" };
+    return { TransformSSE2, MinMaxSSE2, "SSE2" };
+#else
+    return { TransformPlain, MinMaxPlain, "scalar" };
+#endif
+}
+// ---
+// thread-safe initialisation of the static variable since C++11
+static const CoordKernels& GetKernels(void) {
+    static const CoordKernels kernels = SelectKernels();
+    return kernels;
+}
+// ---
+void TransformPoints(const double (&m)[6], double* x, double* y, const size_t n) {
+    GetKernels().transform(m, x, y, n);
+}
+// ---
+void MinMaxValues(const double* v, const size_t n, double& vMin, double& vMax) {
+    GetKernels().minmax(v, n, vMin, vMax);
+}
+// ---
+const char* SimdLevel(void) {
+    return GetKernels().name;
+}
+//
+// ###############################################################
+// ###        END: choose the kernels once for the CPU         ###
+// ###############################################################
+//
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COORDS_H
+#define COORDS_H
+
+#include <cstddef>      // size_t
+#include <vector>       // the coordinate-arrays
+
+
+//
+//--- definition of class "CoordBuffer" ----------------------------------------
+//
+// all x- and all y-values of many primitives in two contiguous arrays
+// ("structure of arrays"): the kernels below work on them in one go
+//
+class CoordBuffer {
+   public:
+      std::vector<double> x;
+      std::vector<double> y;
+      size_t Size(void) const { return x.size(); }
+      void Clear(void) { x.clear(); y.clear(); }
+      void Reserve(const size_t n) { x.reserve(n); y.reserve(n); }
+      // returns the index of the first new value:
+      size_t Append(const double vx, const double vy) {
+                       x.push_back(vx); y.push_back(vy);
+                       return x.size() - 1;
+                       }
+};
+//
+//--- END - definition of class "CoordBuffer" ----------------------------------
+//
+
+
+
+//
+// --- function-prototypes for the coordinate-kernels --------------------------
+//
+// the kernels use AVX2 or SSE2 if the CPU has it, otherwise plain C++;
+// the results are the same in all cases
+//
+// x' = m[0] * x + m[1] * y + m[4]
+// y' = m[2] * x + m[3] * y + m[5]
+// zero-entries of the matrix are skipped (like "AffineTransform::Apply")
+void TransformPoints(const double (&m)[6], double* x, double* y, const size_t n);
+// min. and max. of "n" values (unchanged for n == 0)
+void MinMaxValues(const double* v, const size_t n, double& vMin, double& vMax);
+// the instruction-set in use: "AVX2", "SSE2" or "scalar"
+const char* SimdLevel(void);
+
+
+#endif  //#ifndef COORDS_H
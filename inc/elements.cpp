@@ -29,23 +29,350 @@
 
 #include "helpers.h"
 #include "elements.h"
+#include "fileio.h"
 
 #include <iomanip>      // for IO-Operations
 #include <string>       // for string-handling
 #include <sstream>      // for String-Streams
 #include <algorithm>    // for std::sort
+#include <cstring>      // for strcmp
+#include <charconv>     // for std::from_chars
+#include <iterator>     // for std::size
+#include <unordered_map>  // cache of style-strings
+#include <mutex>          // ... for all threads
+#include <shared_mutex>
+
+
+
+//
+// ###############################################################
+// ###    names of attributes and nodes -> "Attr"/"NodeKind"   ###
+// ###############################################################
+//
+// FNV-1a: at compile-time for the "case"-labels, at runtime for the names
+static constexpr uint32_t NameHash(const char* s) {
+    uint32_t h = 2166136261u;
+    while (*s != '\0') {
+        h ^= (uint8_t)(*s++);
+        h *= 16777619u;
+    }
+    return h;
+}
+// ---
+// the names in the order of "enum class Attr"
+static constexpr const char* AttrNames[] = {
+    "x", "y", "z", "width", "height", "diameter", "rx", "ry",
+    "x1", "y1", "x2", "y2", "length1", "length2", "end1", "end2",
+    "start", "angle", "closed", "antialias", "style",
+    "rotate", "rotation", "Halignment", "Valignment", "font_size", "size", "text_width",
+    "text", "text_from", "font", "color", "frame", "uuid", "keep_visual_rotation", "tagg",
+    "orientation", "type", "name", "version", "link_type", "hotspot_x", "hotspot_y"
+};
+static_assert((sizeof(AttrNames) / sizeof(AttrNames[0])) == (size_t)Attr::unknown,
+              "\"AttrNames\" does not match \"enum class Attr\"");
+static_assert((size_t)Attr::unknown <= 64, "too many attributes for \"ForEachAttr\"");
+// ---
+Attr LookupAttr(const char* name) {
+    Attr id;
+    // two names with the same hash would be a compile-error here:
+    switch (NameHash(name)) {
+        case NameHash("x"):                    id = Attr::x;                    break;
+        case NameHash("y"):                    id = Attr::y;                    break;
+        case NameHash("z"):                    id = Attr::z;                    break;
+        case NameHash("width"):                id = Attr::width;                break;
+        case NameHash("height"):               id = Attr::height;               break;
+        case NameHash("diameter"):             id = Attr::diameter;             break;
+        case NameHash("rx"):                   id = Attr::rx;                   break;
+        case NameHash("ry"):                   id = Attr::ry;                   break;
+        case NameHash("x1"):                   id = Attr::x1;                   break;
+        case NameHash("y1"):                   id = Attr::y1;                   break;
+        case NameHash("x2"):                   id = Attr::x2;                   break;
+        case NameHash("y2"):                   id = Attr::y2;                   break;
+        case NameHash("length1"):              id = Attr::length1;              break;
+        case NameHash("length2"):              id = Attr::length2;              break;
+        case NameHash("end1"):                 id = Attr::end1;                 break;
+        case NameHash("end2"):                 id = Attr::end2;                 break;
+        case NameHash("start"):                id = Attr::start;                break;
+        case NameHash("angle"):                id = Attr::angle;                break;
+        case NameHash("closed"):               id = Attr::closed;               break;
+        case NameHash("antialias"):            id = Attr::antialias;            break;
+        case NameHash("style"):                id = Attr::style;                break;
+        case NameHash("rotate"):               id = Attr::rotate;               break;
+        case NameHash("rotation"):             id = Attr::rotation;             break;
+        case NameHash("Halignment"):           id = Attr::Halignment;           break;
+        case NameHash("Valignment"):           id = Attr::Valignment;           break;
+        case NameHash("font_size"):            id = Attr::font_size;            break;
+        case NameHash("size"):                 id = Attr::size;                 break;
+        case NameHash("text_width"):           id = Attr::text_width;           break;
+        case NameHash("text"):                 id = Attr::text;                 break;
+        case NameHash("text_from"):            id = Attr::text_from;            break;
+        case NameHash("font"):                 id = Attr::font;                 break;
+        case NameHash("color"):                id = Attr::color;                break;
+        case NameHash("frame"):                id = Attr::frame;                break;
+        case NameHash("uuid"):                 id = Attr::uuid;                 break;
+        case NameHash("keep_visual_rotation"): id = Attr::keep_visual_rotation; break;
+        case NameHash("tagg"):                 id = Attr::tagg;                 break;
+        case NameHash("orientation"):          id = Attr::orientation;          break;
+        case NameHash("type"):                 id = Attr::type;                 break;
+        case NameHash("name"):                 id = Attr::name;                 break;
+        case NameHash("version"):              id = Attr::version;              break;
+        case NameHash("link_type"):            id = Attr::link_type;            break;
+        case NameHash("hotspot_x"):            id = Attr::hotspot_x;            break;
+        case NameHash("hotspot_y"):            id = Attr::hotspot_y;            break;
+        default:                               return Attr::unknown;
+    }
+    // an unknown name can have the same hash as a known one:
+    return (strcmp(name, AttrNames[(size_t)id]) == 0) ? id : Attr::unknown;
+}
+// ---
+// the names in the order of "enum class NodeKind"
+static constexpr const char* NodeKindNames[] = {
+    "rect", "arc", "ellipse", "circle", "text", "terminal", "input",
+    "dynamic_text", "line", "polygon"
+};
+static_assert((sizeof(NodeKindNames) / sizeof(NodeKindNames[0])) == (size_t)NodeKind::other,
+              "\"NodeKindNames\" does not match \"enum class NodeKind\"");
+// ---
+NodeKind LookupNodeKind(const char* name) {
+    NodeKind kind;
+    switch (NameHash(name)) {
+        case NameHash("rect"):         kind = NodeKind::rect;         break;
+        case NameHash("arc"):          kind = NodeKind::arc;          break;
+        case NameHash("ellipse"):      kind = NodeKind::ellipse;      break;
+        case NameHash("circle"):       kind = NodeKind::circle;       break;
+        case NameHash("text"):         kind = NodeKind::text;         break;
+        case NameHash("terminal"):     kind = NodeKind::terminal;     break;
+        case NameHash("input"):        kind = NodeKind::input;        break;
+        case NameHash("dynamic_text"): kind = NodeKind::dynamic_text; break;
+        case NameHash("line"):         kind = NodeKind::line;         break;
+        case NameHash("polygon"):      kind = NodeKind::polygon;      break;
+        default:                       return NodeKind::other;
+    }
+    return (strcmp(name, NodeKindNames[(size_t)kind]) == 0) ? kind : NodeKind::other;
+}
+//
+// ###############################################################
+// ###  END: names of attributes and nodes -> "Attr"/"NodeKind" ###
+// ###############################################################
+//
+
+
+
+//
+//--- implementation of class "AttrWriter" -------------------------------------
+//
+AttrWriter::AttrWriter(pugi::xml_node& n, const Attr* ord, const size_t cnt, const Attr frontAttr)
+    : node(n), order(ord), nOrder(cnt), front(frontAttr), scratch(GetScratch())
+{
+    scratch.buf.clear();
+    scratch.entries.clear();
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute&) {
+        present |= (uint64_t)1 << (uint8_t)id;
+    });
+}
+// ---
+AttrWriter::Scratch& AttrWriter::GetScratch(void)
+{
+    static thread_local Scratch s;
+    return s;
+}
+// ---
+void AttrWriter::Store(const Attr id, const size_t off)
+{
+    values[(size_t)id].state = StateSet;
+    values[(size_t)id].off   = off;
+    values[(size_t)id].len   = scratch.buf.size() - off;
+}
+// ---
+void AttrWriter::Set(const Attr id, const char* value)
+{
+    const size_t off = scratch.buf.size();
+    scratch.buf.append(value);
+    Store(id, off);
+}
+// ---
+void AttrWriter::Set(const Attr id, const std::string& value)
+{
+    const size_t off = scratch.buf.size();
+    scratch.buf.append(value);
+    Store(id, off);
+}
+// ---
+void AttrWriter::Set(const Attr id, const double value, const size_t dec)
+{
+    std::string& buf = scratch.buf;
+    const size_t off = buf.size();
+    buf.resize(off + 64);
+    char* end = FormatValueTo(&buf[off], &buf[0] + buf.size(), value, dec);
+    if (end == nullptr) {
+        // very large value or many decimals:
+        buf.resize(off);
+        buf.append(FormatValue(value, dec));
+    } else {
+        buf.resize(end - buf.data());
+    }
+    Store(id, off);
+}
+// ---
+void AttrWriter::Set(const Attr id, const int value)
+{
+    char tmp[16];
+    std::to_chars_result res = std::to_chars(tmp, tmp + sizeof(tmp), value);
+    const size_t off = scratch.buf.size();
+    scratch.buf.append(tmp, res.ptr - tmp);
+    Store(id, off);
+}
+// ---
+// "true" for the first attribute with the name of a point we write
+bool AttrWriter::IsWrittenPoint(const char* name)
+{
+    if ((points == nullptr) || ((name[0] != 'x') && (name[0] != 'y')) ||
+        (name[1] < '1') || (name[1] > '9'))
+        return false;
+    uint64_t idx = 0;
+    std::from_chars_result res = std::from_chars(name + 1, name + strlen(name), idx);
+    if ((res.ec != std::errc()) || (*res.ptr != '\0') || (idx >= scratch.pointFlags.size()))
+        return false;
+    const uint8_t bitWritten = (name[0] == 'x') ? 1 : 2;
+    const uint8_t bitFound   = bitWritten << 2;
+    uint8_t& flags = scratch.pointFlags[idx];
+    if (((flags & bitWritten) == 0) || ((flags & bitFound) != 0))
+        return false;
+    flags |= bitFound;
+    return true;
+}
+// ---
+void AttrWriter::Commit(void)
+{
+    std::string&        buf     = scratch.buf;
+    std::vector<Entry>& entries = scratch.entries;
+    // the indices of the points we write:
+    if (points != nullptr) {
+        uint64_t maxIndex = 0;
+        for (const auto& pt : *points)
+            maxIndex = std::max(maxIndex, pt.i);
+        scratch.pointFlags.assign(maxIndex + 1, 0);
+        for (const auto& pt : *points)
+            scratch.pointFlags[pt.i] |= 3;
+    }
+    // first the "front"-attribute:
+    if ((front != Attr::unknown) && (values[(size_t)front].state == StateSet))
+        entries.push_back({AttrNames[(size_t)front], 0, 0,
+                           values[(size_t)front].off, values[(size_t)front].len, -1});
+    // then the attributes we don't touch - like "remove_attribute" only
+    // the first attribute with the same name is replaced:
+    uint64_t seen = 0;
+    ptrdiff_t slot = 0;
+    for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute(), slot++) {
+        const char* name = attr.name();
+        if (IsWrittenPoint(name))
+            continue;
+        const Attr id = LookupAttr(name);
+        if ((id != Attr::unknown) && (values[(size_t)id].state != StateUnset)) {
+            const uint64_t bit = (uint64_t)1 << (uint8_t)id;
+            if ((seen & bit) == 0) {
+                seen |= bit;
+                continue;
+            }
+        }
+        if ((ptrdiff_t)entries.size() == slot) {
+            // stays where it is:
+            entries.push_back({nullptr, 0, 0, 0, 0, slot});
+        } else {
+            // moves: keep a copy before the slot is overwritten
+            Entry e{nullptr, buf.size(), strlen(name), 0, 0, -1};
+            buf.append(name, e.nameLen + 1);
+            e.valOff = buf.size();
+            buf.append(attr.value());
+            e.valLen = buf.size() - e.valOff;
+            entries.push_back(e);
+        }
+    }
+    // and the new attributes in the order of the table:
+    for (size_t k = 0; k < nOrder; k++) {
+        const Attr id = order[k];
+        if (id == Attr::points) {
+            if (points == nullptr) continue;
+            for (const auto& pt : *points) {
+                for (const char c : {'x', 'y'}) {
+                    Entry e{nullptr, buf.size(), 0, 0, 0, -1};
+                    char tmp[24];
+                    tmp[0] = c;
+                    char* end = std::to_chars(tmp + 1, tmp + sizeof(tmp), pt.i).ptr;
+                    e.nameLen = end - tmp;
+                    buf.append(tmp, e.nameLen);
+                    buf.push_back('\0');
+                    e.valOff = buf.size();
+                    buf.resize(e.valOff + 64);
+                    const double v = (c == 'x') ? pt.x : pt.y;
+                    char* vEnd = FormatValueTo(&buf[e.valOff], &buf[0] + buf.size(), v, pointDecimals);
+                    if (vEnd == nullptr) {
+                        buf.resize(e.valOff);
+                        buf.append(FormatValue(v, pointDecimals));
+                    } else {
+                        buf.resize(vEnd - buf.data());
+                    }
+                    e.valLen = buf.size() - e.valOff;
+                    entries.push_back(e);
+                }
+            }
+        } else if (values[(size_t)id].state == StateSet) {
+            entries.push_back({AttrNames[(size_t)id], 0, 0,
+                               values[(size_t)id].off, values[(size_t)id].len, -1});
+        }
+    }
+    // overwrite the existing attributes in place, append or remove the rest:
+    pugi::xml_attribute attr = node.first_attribute();
+    size_t i = 0;
+    for (; (i < entries.size()) && attr; i++, attr = attr.next_attribute()) {
+        const Entry& e = entries[i];
+        if (e.slot == (ptrdiff_t)i)
+            continue;
+        const char* name = (e.name != nullptr) ? e.name : (buf.data() + e.nameOff);
+        const char* val  = buf.data() + e.valOff;
+        if (strcmp(attr.name(), name) != 0)
+            attr.set_name(name);
+        const char* old = attr.value();
+        if ((strlen(old) != e.valLen) || (memcmp(old, val, e.valLen) != 0))
+            attr.set_value(val, e.valLen);
+    }
+    for (; i < entries.size(); i++) {
+        const Entry& e = entries[i];
+        const char* name = (e.name != nullptr) ? e.name : (buf.data() + e.nameOff);
+        node.append_attribute(name).set_value(buf.data() + e.valOff, e.valLen);
+    }
+    while (attr) {
+        pugi::xml_attribute next = attr.next_attribute();
+        node.remove_attribute(attr);
+        attr = next;
+    }
+}
+//
+//--- END - implementation of class "AttrWriter" -------------------------------
+//
 
 //
 //--- implementation of class "DefinitionLine" ---------------------------------
 //
 void DefinitionLine::ReadFromPugiNode(pugi::xml_node node)
 {
-    version   = node.attribute("version").as_string();
-    link_type = node.attribute("link_type").as_string();
-    type      = node.attribute("type").as_string();
-    ReadSize(node);
-    hotspot_x = node.attribute("hotspot_x").as_int();
-    hotspot_y = node.attribute("hotspot_y").as_int();
+    version   = "";
+    link_type = "";
+    type      = "";
+    hotspot_x = 0;
+    hotspot_y = 0;
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadSizeAttr(id, attr)) return;
+        switch (id) {
+            case Attr::version:   version   = attr.value();  break;
+            case Attr::link_type: link_type = attr.value();  break;
+            case Attr::type:      type      = attr.value();  break;
+            case Attr::hotspot_x: hotspot_x = attr.as_int(); break;
+            case Attr::hotspot_y: hotspot_y = attr.as_int(); break;
+            default: break;
+        }
+    });
+    ReadSizeDone(node);
 }
 // ---
 void DefinitionLine::ReCalc(RectMinMax XYMinMax) {
@@ -68,19 +395,21 @@ void DefinitionLine::ReCalc(RectMinMax XYMinMax) {
     hotspot_y = -((int)round(XYMinMax.ymin() - (ymargin/2)));
 }
 // ---
+static constexpr Attr OrderDefinitionLine[] = {
+    Attr::version, Attr::type, Attr::link_type, Attr::width, Attr::height,
+    Attr::hotspot_x, Attr::hotspot_y
+};
+// ---
 void DefinitionLine::WriteToPugiNode(pugi::xml_node node)
 {   // sort attributes:
-    node.remove_attribute("version");
-    node.append_attribute("version").set_value(version);
-    node.remove_attribute("type");
-    node.append_attribute("type").set_value(type);
-    node.remove_attribute("link_type");
-    node.append_attribute("link_type").set_value(link_type);
-    WriteSize(node, 0);
-    node.remove_attribute("hotspot_x");
-    node.append_attribute("hotspot_x").set_value(std::to_string(hotspot_x));
-    node.remove_attribute("hotspot_y");
-    node.append_attribute("hotspot_y").set_value(std::to_string(hotspot_y));
+    AttrWriter w(node, OrderDefinitionLine);
+    w.Set(Attr::version, version);
+    w.Set(Attr::type, type);
+    w.Set(Attr::link_type, link_type);
+    WriteSize(w, 0);
+    w.Set(Attr::hotspot_x, hotspot_x);
+    w.Set(Attr::hotspot_y, hotspot_y);
+    w.Commit();
 }
 //
 //--- END - implementation of class "DefinitionLine" ---------------------------
@@ -165,27 +494,30 @@ void ElementInfo::WriteToPugiNode(pugi::xml_node node)
 //
 void BasePosition::ReadPosition(pugi::xml_node& node)
 {
-    x = node.attribute("x").as_double();
-    y = node.attribute("y").as_double();
-    if (node.attribute("z")) {
-        z = node.attribute("z").as_double();
-    }
+    x = 0.0;
+    y = 0.0;
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        ReadPositionAttr(id, attr);
+    });
 }
-void BasePosition::WritePosition(pugi::xml_node& node, const size_t& decimals)
+// ---
+// for the attribute-loop of the derived classes: "true", if "id" was handled
+// (x and y are "0", if not there - the caller has to preset them)
+bool BasePosition::ReadPositionAttr(const Attr id, const pugi::xml_attribute& attr)
 {
-    if (node.attribute("x")) {
-        node.remove_attribute("x");
-        node.append_attribute("x").set_value(FormatValue(x, decimals));
-    }
-    if (node.attribute("y")) {
-        node.remove_attribute("y");
-        node.append_attribute("y").set_value(FormatValue(y, decimals));
-    }
-    if (node.attribute("z")) {
-        node.remove_attribute("z");
-        node.append_attribute("z").set_value(FormatValue(z, 0));
+    switch (id) {
+        case Attr::x: x = ParseDouble(attr.value()); return true;
+        case Attr::y: y = ParseDouble(attr.value()); return true;
+        case Attr::z: z = ParseDouble(attr.value()); return true;
+        default:      return false;
     }
 }
+void BasePosition::WritePosition(AttrWriter& w, const size_t& decimals)
+{
+    w.SetIfPresent(Attr::x, x, decimals);
+    w.SetIfPresent(Attr::y, y, decimals);
+    w.SetIfPresent(Attr::z, z, 0);
+}
 //
 //--- END - implementation of class BasePosition -------------------------------
 //
@@ -195,32 +527,48 @@ void BasePosition::WritePosition(pugi::xml_node& node, const size_t& decimals)
 //
 void BaseSize::ReadSize(pugi::xml_node& node)
 {
-    if (node.attribute("width")) {
-        width  = node.attribute("width").as_double();
-    }
-    if (node.attribute("height")) {
-        height = node.attribute("height").as_double();
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        ReadSizeAttr(id, attr);
+    });
+    ReadSizeDone(node);
+}
+// ---
+// for the attribute-loop of the derived classes: "true", if "id" was handled
+bool BaseSize::ReadSizeAttr(const Attr id, const pugi::xml_attribute& attr)
+{
+    switch (id) {
+        case Attr::width:
+            if (!xDiameter) width  = ParseDouble(attr.value());
+            return true;
+        case Attr::height:
+            if (!xDiameter) height = ParseDouble(attr.value());
+            return true;
+        case Attr::diameter:
+            // beim Element "circle" gibt's den Durchmesser
+            // --> umwandeln in "ellipse" mit "width"/"height"
+            width  = ParseDouble(attr.value());
+            height = width;
+            xDiameter = true;
+            return true;
+        default:
+            return false;
     }
-    if (node.attribute("diameter")) {
-        // beim Element "circle" gibt's den Durchmesser
-        // --> umwandeln in "ellipse" mit "width"/"height"
-        width  = node.attribute("diameter").as_double();
-        height = width;
+}
+// ---
+// after the attribute-loop: the node of a "circle" gets "width"/"height"
+void BaseSize::ReadSizeDone(pugi::xml_node& node)
+{
+    if (xDiameter) {
         node.remove_attribute("diameter");
         node.append_attribute("width").set_value(width);
         node.append_attribute("height").set_value(width);
+        xDiameter = false;
     }
 }
-void BaseSize::WriteSize(pugi::xml_node& node, const size_t& dec)
+void BaseSize::WriteSize(AttrWriter& w, const size_t& dec)
 {
-    if (node.attribute("width")) {
-        node.remove_attribute("width");
-        node.append_attribute("width").set_value(FormatValue(width, dec));
-    }
-    if (node.attribute("height")) {
-        node.remove_attribute("height");
-        node.append_attribute("height").set_value(FormatValue(height, dec));
-    }
+    w.SetIfPresent(Attr::width,  width,  dec);
+    w.SetIfPresent(Attr::height, height, dec);
 }
 //
 //--- END - implementation of class BaseSize -----------------------------------
@@ -256,47 +604,102 @@ void AuthorInfo::WriteToPugiNode(pugi::xml_node node)
 //
 //--- implementation of class "BaseStyle" --------------------------------------
 //
-std::string BaseStyle::StyleAsSVGstring(const size_t& decimals)
-{
+static constexpr std::string_view LineStyleNames[] = {
+    "normal", "dotted", "dashed", "dashdotted"
+};
+static constexpr std::string_view LineWeightNames[] = {
+    "none", "thin", "normal", "hight", "eleve"
+};
+// ---
+static bool StartsWith(std::string_view s, std::string_view prefix) {
+    return (s.substr(0, prefix.length()) == prefix);
+}
+// ---
+static LineStyle LookupLineStyle(std::string_view s) {
+    for (size_t i = 0; i < std::size(LineStyleNames); i++)
+        if (LineStyleNames[i] == s) return static_cast<LineStyle>(i);
+    return LineStyle::normal;
+}
+// ---
+static LineWeight LookupLineWeight(std::string_view s) {
+    for (size_t i = 0; i < std::size(LineWeightNames); i++)
+        if (LineWeightNames[i] == s) return static_cast<LineWeight>(i);
+    return LineWeight::normal;
+}
+// ---
 // in Element:   style = "line-style:normal;line-weight:normal;filling:none;color:black"
 // SVG-Beispiel: style="fill:yellow;stroke:purple;stroke-width:2"
 //               style="stroke:rgb(255,0,0);stroke-width:2"
 //
-    // wir teilen den Style-String zunächst in Teil-Strings:
-    std::vector<std::string> vsStyleParts;
-    std::string text = style;
-    //std::cerr << text << std::endl;
-    size_t pos;
-    std::string delimiter = ";";
-    while ((pos = text.find(delimiter)) != std::string::npos) {
-        vsStyleParts.push_back(text.substr(0, pos));
-        text.erase(0, pos + delimiter.length());
-    }
-    // der letzte teil muss auch mit:
-    vsStyleParts.push_back(text);
-    // wir teilen den style-string auf und bestimmen die Werte:
-    std::string s = "";
-    //
-    for (const auto& str : vsStyleParts) {
-        std::string val = str;
-        // wir bestimmen die einzelnen Linien-Parameter:
-        if (val.rfind("line-style:", 0) == 0) { // pos=0 limits the search to the prefix
-            val.erase(0, std::string("line-style:").length());
-            lineStyle = val;
-        }
-        if (val.rfind("line-weight:", 0) == 0) { // pos=0 limits the search to the prefix
-            val.erase(0, std::string("line-weight:").length());
-            lineWeight = val;
-        }
-        if (val.rfind("color:", 0) == 0) { // pos=0 limits the search to the prefix
-            val.erase(0, std::string("color:").length());
-            lineColor = val;
-        }
-        if (val.rfind("filling:", 0) == 0) { // pos=0 limits the search to the prefix
-            val.erase(0, std::string("filling:").length());
-            lineFilling = val;
+// in a collection of elements there are only a few different style-strings:
+// every one is parsed only once and the result is kept for all threads
+struct StyleInfo {
+    LineStyle   lineStyle;
+    LineWeight  lineWeight;
+    const char* lineFilling;
+    const char* lineColor;
+    std::string svg;          // the attributes for SVG
+};
+// the entries are never changed or deleted: references stay valid
+// (the nodes of "unordered_map" do not move)
+static std::shared_mutex StyleCacheMutex;
+static std::unordered_map<size_t, std::unordered_map<std::string, StyleInfo>> StyleCache;  // decimals -> style -> info
+// ---
+const std::string& BaseStyle::StyleAsSVGstring(const size_t& decimals)
+{
+    {   // already known?
+        std::shared_lock<std::shared_mutex> lock(StyleCacheMutex);
+        const auto itDec = StyleCache.find(decimals);
+        if (itDec != StyleCache.end()) {
+            const auto it = itDec->second.find(style);
+            if (it != itDec->second.end()) {
+                const StyleInfo& info = it->second;
+                lineStyle   = info.lineStyle;
+                lineWeight  = info.lineWeight;
+                lineFilling = info.lineFilling;
+                lineColor   = info.lineColor;
+                return info.svg;
+            }
         }
     }
+    // a new one: parse it (without lock) ...
+    ParseStyle();
+    StyleInfo info { lineStyle, lineWeight, lineFilling, lineColor, BuildSVGstring(decimals) };
+    // ... and add it: if another thread was faster, we take its (identical) entry
+    std::unique_lock<std::shared_mutex> lock(StyleCacheMutex);
+    return StyleCache[decimals].emplace(style, std::move(info)).first->second.svg;
+}
+// ---
+void BaseStyle::ParseStyle(void)
+{
+    lineStyle   = LineStyle::normal;
+    lineWeight  = LineWeight::normal;
+    lineFilling = "none";
+    lineColor   = "#000000";
+    // wir gehen durch die Teil-Strings (getrennt durch ";") und bestimmen
+    // die Werte - ohne Kopien: nur Views auf "style"
+    std::string_view text = style;
+    while (true) {
+        const size_t pos = text.find(';');
+        const std::string_view val = text.substr(0, pos);
+        // wir bestimmen die einzelnen Linien-Parameter:
+        if      (StartsWith(val, "line-style:"))
+            lineStyle = LookupLineStyle(val.substr(11));
+        else if (StartsWith(val, "line-weight:"))
+            lineWeight = LookupLineWeight(val.substr(12));
+        else if (StartsWith(val, "color:"))
+            lineColor = ColorToValue(val.substr(6));
+        else if (StartsWith(val, "filling:"))
+            lineFilling = ColorToValue(val.substr(8));
+        if (pos == std::string_view::npos)
+            break;  // das war der letzte Teil
+        text.remove_prefix(pos + 1);
+    }
+}
+// ---
+std::string BaseStyle::BuildSVGstring(const size_t& decimals)
+{
+    std::string s = "";
 
     // und nun den SVG-String bauen:
     double dStrokeWidth = GetLineWidth();
@@ -306,13 +709,13 @@ std::string BaseStyle::StyleAsSVGstring(const size_t& decimals)
     // "line-style:dashed" --> stroke-dasharray="4,3"
     // "line-style:dashdotted" --> stroke-dasharray="8,2,1,2"
     // aber abhängig von der Strichbreite!
-    if      (lineStyle == "dotted")
+    if      (lineStyle == LineStyle::dotted)
         s += "stroke-dasharray=\"" + FormatValue((1.0 * dStrokeWidth), decimals) + "," +
                                      FormatValue((2.0 * dStrokeWidth), decimals) + "\" ";
-    else if (lineStyle == "dashed")
+    else if (lineStyle == LineStyle::dashed)
         s += "stroke-dasharray=\"" + FormatValue((4.0 * dStrokeWidth), decimals) + "," +
                                      FormatValue((2.0 * dStrokeWidth), decimals) + "\" ";
-    else if (lineStyle == "dashdotted")
+    else if (lineStyle == LineStyle::dashdotted)
         s += "stroke-dasharray=\"" + FormatValue((4.0 * dStrokeWidth), decimals) + "," +
                                      FormatValue((2.0 * dStrokeWidth), decimals) + "," +
                                      FormatValue((1.0 * dStrokeWidth), decimals) + "," +
@@ -322,10 +725,14 @@ std::string BaseStyle::StyleAsSVGstring(const size_t& decimals)
     s += "stroke-width=\"" + FormatValue((dStrokeWidth), decimals) + "\" ";
 
     // "filling:none" --> fill:none
-    s += "fill=\"" + ColorToValue(lineFilling) + "\" ";
+    s += "fill=\"";
+    s += lineFilling;
+    s += "\" ";
 
     // "color:black" --> stroke="black"
-    s += "stroke=\"" + ColorToValue(lineColor) + "\" ";
+    s += "stroke=\"";
+    s += lineColor;
+    s += "\" ";
 
     // letztes Semikolon löschen:
     s.erase(s.length()-1, 1);
@@ -352,35 +759,23 @@ in diesen dynamic_text umgewandelt:
 DAS wollen wir hier auch machen!
 */
 {
-    for (pugi::xml_attribute_iterator ait = node.attributes_begin(); ait != node.attributes_end(); ++ait)
-    {
-        if (_DEBUG_)
-            std::cerr << "  " << ait->name() << "=" << ait->value();
-        if ((std::string)ait->name() == "x") {
-            x = node.attribute("x").as_double();
-        }
-        if ((std::string)ait->name() == "y") {
-            y = node.attribute(ait->name()).as_double();
-        }
-        if ((std::string)ait->name() == "rotate") {
-            rotate = node.attribute(ait->name()).as_bool();
-        }
-        if ((std::string)ait->name() == "rotation") {
-            rotation = node.attribute(ait->name()).as_double();
-        }
-        if ((std::string)ait->name() == "size") {
-            size = node.attribute(ait->name()).as_double();
-        }
-        if ((std::string)ait->name() == "tagg") {
-            // wird zu: "text_from" und "info_name"
-            tagg = node.attribute(ait->name()).as_string();
-        }
-        if ((std::string)ait->name() == "text") {
-            text = node.attribute(ait->name()).as_string();
-        }
-    }
-    if (_DEBUG_)
+    if (_DEBUG_) {
+        for (pugi::xml_attribute attr : node.attributes())
+            std::cerr << "  " << attr.name() << "=" << attr.value();
         std::cerr << "\n";
+    }
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        switch (id) {
+            case Attr::x:        x        = ParseDouble(attr.value()); break;
+            case Attr::y:        y        = ParseDouble(attr.value()); break;
+            case Attr::rotate:   rotate   = ParseBool(attr.value());   break;
+            case Attr::rotation: rotation = ParseDouble(attr.value()); break;
+            case Attr::size:     size     = ParseDouble(attr.value()); break;
+            case Attr::tagg:     tagg     = attr.value();              break;  // wird zu: "text_from" und "info_name"
+            case Attr::text:     text     = attr.value();              break;
+            default: break;
+        }
+    });
     // die bekannten und eingelesenen Attribute löschen:
     node.remove_attribute("x");
     node.remove_attribute("y");
@@ -398,7 +793,7 @@ DAS wollen wir hier auch machen!
     node.append_attribute("z").set_value("1");
     node.append_attribute("rotation").set_value(FormatValue(rotation, 0));
     node.append_attribute("font").set_value("Liberation Sans," + FormatValue(size, 0) + ",-1,5,25,0,0,0,0,0,Regular");
-    node.append_attribute("uuid").set_value("{" + CreateUUID(false) + "}");
+    node.append_attribute("uuid").set_value(CreateBracedUUID().c_str());
     if (tagg == "label" ) {
         node.append_attribute("text_from").set_value("ElementInfo");
     } else {
@@ -428,44 +823,64 @@ DAS wollen wir hier auch machen!
 //
 //--- implementation of class "ElmtDynText" ------------------------------------
 //
+// the font-attributes of "text" and "dynamic_text" for SVG: with
+// "--svg-classes" they become a class like the styles of the other primitives
+static void WriteFontAttrs(SvgWriter& w, const char* family, const double size,
+                           const size_t decimals, const std::string& color)
+{
+    if (w.HasClasses() == false) {
+        w << "font-family=\"" << family << "\" ";
+        w << "font-size=\""; w.Num(size, decimals) << "pt\" ";
+        w << "fill=\"" << color << '"';
+        return;
+    }
+    std::string s = "font-family=\"";
+    s += family;
+    s += "\" font-size=\"" + FormatValue(size, decimals) + "pt\" ";
+    s += "fill=\"" + color + "\"";
+    w.Attrs(s);
+}
+// ---
 void ElmtDynText::ReadFromPugiNode(pugi::xml_node& node)
 {
-    ReadPosition(node);
-    if (node.attribute("rotate"))
-        rotate    = node.attribute("rotate").as_bool(); // scheint eine Rotation um 0° zu sein!
-    if (node.attribute("rotation"))
-        rotation  = node.attribute("rotation").as_double();
-    if (node.attribute("Halignment"))
-        Halignment= node.attribute("Halignment").as_string();
-    if (node.attribute("Valignment"))
-        Valignment= node.attribute("Valignment").as_string();
-    if (node.attribute("font_size"))
-        size      = node.attribute("font_size").as_double();
-    if (node.attribute("size"))
-        size      = node.attribute("size").as_double();
-    if (node.attribute("text_width"))
-        text_width= node.attribute("text_width").as_double();
-    if (node.attribute("text"))
-        text      = node.attribute("text").as_string();
-    if (node.attribute("text_from"))
-        text_from = node.attribute("text_from").as_string();
-    if (node.attribute("font"))
-        font      = node.attribute("font").as_string();
-    if (node.attribute("color"))
-        color     = node.attribute("color").as_string();
-    if (node.attribute("frame"))
-        frame     = node.attribute("frame").as_bool();
-    if (node.attribute("uuid")) {
-        uuid      = node.attribute("uuid").as_string();
+    x = 0.0;
+    y = 0.0;
+    const char* pSize     = nullptr;  // "size" wins over "font_size"
+    const char* pFontSize = nullptr;
+    const char* pUUID     = nullptr;
+    ForEachAttr(node, [&](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadPositionAttr(id, attr)) return;
+        switch (id) {
+            case Attr::rotate:     rotate     = ParseBool(attr.value());   break;  // scheint eine Rotation um 0° zu sein!
+            case Attr::rotation:   rotation   = ParseDouble(attr.value()); break;
+            case Attr::Halignment: Halignment = attr.value();              break;
+            case Attr::Valignment: Valignment = attr.value();              break;
+            case Attr::font_size:  pFontSize  = attr.value();              break;
+            case Attr::size:       pSize      = attr.value();              break;
+            case Attr::text_width: text_width = ParseDouble(attr.value()); break;
+            case Attr::text:       text       = attr.value();              break;
+            case Attr::text_from:  text_from  = attr.value();              break;
+            case Attr::font:       font       = attr.value();              break;
+            case Attr::color:      color      = attr.value();              break;
+            case Attr::frame:      frame      = ParseBool(attr.value());   break;
+            case Attr::uuid:       pUUID      = attr.value();              break;
+            case Attr::keep_visual_rotation:
+                                   keep_visual_rotation = ParseBool(attr.value()); break;
+            default: break;
+        }
+    });
+    if (pSize != nullptr)
+        size      = ParseDouble(pSize);
+    else if (pFontSize != nullptr)
+        size      = ParseDouble(pFontSize);
+    if (pUUID != nullptr) {
+        uuid      = pUUID;
         if (uuid.length() != 38)
-            uuid  = "{" + CreateUUID(false) + "}";
+            uuid  = CreateBracedUUID().c_str();
     } else {
-        uuid      = "{" + CreateUUID(false) + "}";
+        uuid      = CreateBracedUUID().c_str();
         node.append_attribute("uuid").set_value(uuid);
     }
-    if (node.attribute("keep_visual_rotation"))
-        keep_visual_rotation
-                  = node.attribute("keep_visual_rotation").as_bool();
 
     // nun die Unter-Elemente:
     if (node.child("text"))
@@ -491,67 +906,36 @@ void ElmtDynText::ReadFromPugiNode(pugi::xml_node& node)
     }
 }
 // ---
+static constexpr Attr OrderDynText[] = {
+    Attr::x, Attr::y, Attr::z, Attr::text_width, Attr::Halignment, Attr::Valignment,
+    Attr::frame, Attr::rotate, Attr::rotation, Attr::keep_visual_rotation,
+    Attr::text_from, Attr::size, Attr::font_size, Attr::text, Attr::uuid,
+    Attr::font, Attr::color
+};
+// ---
 void ElmtDynText::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
 {
-    // Attribute löschen und wieder anfügen zum sortieren
-    WritePosition(node, decimals);
-    if (node.attribute("text_width")) {
-        node.remove_attribute("text_width");
+    // alle Attribute in einem Durchgang sortieren
+    AttrWriter w(node, OrderDynText);
+    WritePosition(w, decimals);
+    if (w.Has(Attr::text_width)) {
         if ( text_width < 0.0 ) { text_width = -1.0; }
-        node.append_attribute("text_width").set_value(FormatValue(text_width, 0));
-    }
-    if (node.attribute("Halignment")) {
-        node.remove_attribute("Halignment");
-        node.append_attribute("Halignment").set_value(Halignment);
-    }
-    if (node.attribute("Valignment")) {
-        node.remove_attribute("Valignment");
-        node.append_attribute("Valignment").set_value(Valignment);
-    }
-    if (node.attribute("frame")) {
-        node.remove_attribute("frame");
-        node.append_attribute("frame").set_value(frame);
-    }
-    if (node.attribute("rotate")) {
-        node.remove_attribute("rotate");
-        node.append_attribute("rotate").set_value(rotate);
-    }
-    if (node.attribute("rotation")) {
-        node.remove_attribute("rotation");
-        node.append_attribute("rotation").set_value(FormatValue(rotation, 0));
-    }
-    if (node.attribute("keep_visual_rotation")) {
-        node.remove_attribute("keep_visual_rotation");
-        node.append_attribute("keep_visual_rotation").set_value((keep_visual_rotation ? "true" : "false"));
-    }
-    if (node.attribute("text_from")) {
-        node.remove_attribute("text_from");
-        node.append_attribute("text_from").set_value(text_from);
-    }
-    if (node.attribute("size")) {
-        node.remove_attribute("size");
-        node.append_attribute("size").set_value(FormatValue(size, 0));
-    }
-    if (node.attribute("font_size")) {
-        node.remove_attribute("font_size");
-        node.append_attribute("font_size").set_value(FormatValue(size, 0));
-    }
-    if (node.attribute("text")) { // noch nötig??
-        node.remove_attribute("text");
-        node.append_attribute("text").set_value(text);
-    }
-    if (node.attribute("uuid")) {
-        node.remove_attribute("uuid");
-        node.append_attribute("uuid").set_value(uuid);
-    }
-    if (node.attribute("font")) {
-        node.remove_attribute("font");
-        node.append_attribute("font").set_value(font);
-    }
-    if (node.attribute("color")) {
-        node.remove_attribute("color");
-        node.append_attribute("color").set_value(color);
-    }
+        w.Set(Attr::text_width, text_width, 0);
+    }
+    w.SetIfPresent(Attr::Halignment, Halignment);
+    w.SetIfPresent(Attr::Valignment, Valignment);
+    w.SetIfPresent(Attr::frame, frame);
+    w.SetIfPresent(Attr::rotate, rotate);
+    w.SetIfPresent(Attr::rotation, rotation, 0);
+    w.SetIfPresent(Attr::keep_visual_rotation, keep_visual_rotation);
+    w.SetIfPresent(Attr::text_from, text_from);
+    w.SetIfPresent(Attr::size, size, 0);
+    w.SetIfPresent(Attr::font_size, size, 0);
+    w.SetIfPresent(Attr::text, text); // noch nötig??
+    w.SetIfPresent(Attr::uuid, uuid);
+    w.SetIfPresent(Attr::font, font);
+    w.SetIfPresent(Attr::color, color);
+    w.Commit();
     // nun die Unter-Elemente:
     if (node.child("text"))
         node.child("text").text().set(text);
@@ -563,22 +947,25 @@ void ElmtDynText::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
         node.child("composite_text").text().set(composite_text);
 }
 // ---
-void ElmtDynText::Rot90(void){
-    RotPoint90(x, y);
-    rotation += 90;
-    if (rotation >= 360.0){
-        rotation -= 360;
+void ElmtDynText::Transform(const AffineTransform& t){
+    t.Apply(x, y);
+    const double rot = t.GetRotation();
+    if (rot != 0.0) {
+        rotation += rot;
+        if (rotation >= 360.0) rotation = std::fmod(rotation, 360.0);
+        if ((rot < 0.0) && (rotation < 0.0)) rotation += 360.0;
     }
+    size *= t.GetSizeFactor();
+    CreateFontString();
 }
 // ---
-std::string ElmtDynText::AsSVGstring(const size_t& decimals)
+void ElmtDynText::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
     // Positionen x, y, Rotationspunkt, für die beiden Varianten berechnen
     double posx;
     double posy;
     double rotx;
     double roty;
-    std::string s = "";
     // Position und Rotationspunkt berechnen:
     posx = ((x + (size/8.0)+4.05) - 0.5);
     posy = y + (7.0/5.0*size + 26.0/5.0) - 0.5;
@@ -590,37 +977,34 @@ std::string ElmtDynText::AsSVGstring(const size_t& decimals)
         //std::cerr << "\"dynamic_text\" mit Umbruch erkannt!\n";
         std::vector<std::string> vsText;
         MultiLineText(text, vsText);
-        s += "<text y=\"" + FormatValue(posy, decimals) + "\" transform=\"rotate(";
-        s += FormatValue(rotation, decimals) + " " + FormatValue(x, decimals) + " " + FormatValue(y, decimals) + ")\" ";
-        s += "font-family=\"" + FontToFontFamily(vsFont[0]) + "\" ";
-        s += "font-size=\"" + FormatValue(size, 0) + "pt\" ";
-        s += "fill=\"" + color + "\">\n";
+        w << "<text y=\""; w.Num(posy, decimals) << "\" transform=\"rotate(";
+        w.Num(rotation, decimals) << ' '; w.Num(x, decimals) << ' '; w.Num(y, decimals) << ")\" ";
+        WriteFontAttrs(w, FontToFontFamily(vsFont[0]), size, 0, color);
+        w << ">\n";
         for (size_t i=0; i<vsText.size(); i++) {
-            s += "      <tspan x=\"" + FormatValue(posx, decimals) + "\" dy=\"" + FormatValue(((i>0)*1.4), decimals) + "em\">";
-            s += TextToEntity(vsText[i]) + "</tspan>\n";
+            w << "      <tspan x=\""; w.Num(posx, decimals) << "\" dy=\""; w.Num(((i>0)*1.4), decimals) << "em\">";
+            w.Text(vsText[i]) << "</tspan>\n";
         }
-        s += "      </text>";
+        w << "      </text>";
         // für Multiline-Text in "dynamic_text" war's das
-        return s;
+        return;
     }
 
     // bei einzeiligem Text bleibt alles wie's war:
-    s += "<text transform=\"translate(" ;
-    s += FormatValue(posx, 1) + ", ";
-    s += FormatValue(posy, 1) + ")";
+    w << "<text transform=\"translate(" ;
+    w.Num(posx, 1) << ", ";
+    w.Num(posy, 1) << ')';
     if (std::abs(rotation) > 0.1) {
-        s += " rotate(" + FormatValue(rotation, 1);
-        s += " " + FormatValue(rotx, 1);
-        s += " " + FormatValue(roty, 1);
-        s += ")";
+        w << " rotate("; w.Num(rotation, 1);
+        w << ' '; w.Num(rotx, 1);
+        w << ' '; w.Num(roty, 1);
+        w << ')';
     }
-    s += "\" ";
+    w << "\" ";
     // wir nutzen hier generische Schriftfamilien!!!
-    s += "font-family=\"" + FontToFontFamily(vsFont[0]) + "\" ";
-    s += "font-size=\"" + FormatValue(size, decimals) + "pt\" ";
-    s += "fill=\"" + color + "\">";
-    s += TextToEntity(text) + "</text>";
-    return s;
+    WriteFontAttrs(w, FontToFontFamily(vsFont[0]), size, decimals, color);
+    w << ">";
+    w.Text(text) << "</text>";
 }
 // ---
 void ElmtDynText::SplitFontString(void)
@@ -655,13 +1039,23 @@ void ElmtDynText::CreateFontString(void)
 //
 void ElmtText::ReadFromPugiNode(pugi::xml_node& node)
 {
-    ReadPosition(node);
-    size      = node.attribute("size").as_double();
-    rotation  = node.attribute("rotation").as_double();
-    text      = node.attribute("text").as_string();
-    font      = node.attribute("font").as_string();
-    if (node.attribute("color"))
-        color     = node.attribute("color").as_string();
+    x         = 0.0;
+    y         = 0.0;
+    size      = 0.0;
+    rotation  = 0.0;
+    text      = "";
+    font      = "";
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadPositionAttr(id, attr)) return;
+        switch (id) {
+            case Attr::size:     size     = ParseDouble(attr.value()); break;
+            case Attr::rotation: rotation = ParseDouble(attr.value()); break;
+            case Attr::text:     text     = attr.value();              break;
+            case Attr::font:     font     = attr.value();              break;
+            case Attr::color:    color    = attr.value();              break;
+            default: break;
+        }
+    });
 
     // ToDo: Schrift und Schriftgröße bearbeiten:
     if ( font.length() > 0) {
@@ -677,38 +1071,35 @@ void ElmtText::ReadFromPugiNode(pugi::xml_node& node)
     }
 }
 // ---
+static constexpr Attr OrderText[] = {
+    Attr::x, Attr::y, Attr::z, Attr::size, Attr::rotation, Attr::font, Attr::color
+};
+// ---
 void ElmtText::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
-{   // sort attributes by removing and re-adding
-    node.remove_attribute("text");
-    node.prepend_attribute("text").set_value(text);
-    WritePosition(node, decimals);
-    if (node.attribute("size")) {
-        node.remove_attribute("size");
-        node.append_attribute("size").set_value(FormatValue(size, 0));
-    }
-    if (node.attribute("rotation")) {
-        node.remove_attribute("rotation");
-        node.append_attribute("rotation").set_value(FormatValue(rotation, 0));
-    }
-    if (node.attribute("font")) {
-        node.remove_attribute("font");
-        node.append_attribute("font").set_value(font);
-    }
-    if (node.attribute("color")) {
-        node.remove_attribute("color");
-        node.append_attribute("color").set_value(color);
-    }
+{   // sort attributes: "text" first
+    AttrWriter w(node, OrderText, Attr::text);
+    w.Set(Attr::text, text);
+    WritePosition(w, decimals);
+    w.SetIfPresent(Attr::size, size, 0);
+    w.SetIfPresent(Attr::rotation, rotation, 0);
+    w.SetIfPresent(Attr::font, font);
+    w.SetIfPresent(Attr::color, color);
+    w.Commit();
 }
 // ---
-void ElmtText::Rot90(void){
-    RotPoint90(x, y);
-    rotation += 90;
-    if (rotation >= 360.0){
-        rotation -= 360;
+void ElmtText::Transform(const AffineTransform& t){
+    t.Apply(x, y);
+    const double rot = t.GetRotation();
+    if (rot != 0.0) {
+        rotation += rot;
+        if (rotation >= 360.0) rotation = std::fmod(rotation, 360.0);
+        if ((rot < 0.0) && (rotation < 0.0)) rotation += 360.0;
     }
+    size *= t.GetSizeFactor();
+    CreateFontString();
 }
 // ---
-std::string ElmtText::AsSVGstring(const size_t& decimals)
+void ElmtText::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
     // mehrzeiliger Text wird in einem "Vector of String" abgelegt
     // als Trennzeichen für die Teil-Strings: "\n" und "\r"
@@ -716,33 +1107,27 @@ std::string ElmtText::AsSVGstring(const size_t& decimals)
          (!(text.find("\r") == std::string::npos)) )  {
         std::vector<std::string> vsText;
         MultiLineText(text, vsText);
-        // wir brauchen einen String für den Rückgabewert:
-        std::string s = "";
-        s += "<text y=\"" + FormatValue(y, decimals) + "\" transform=\"rotate(";
-        s += FormatValue(rotation, decimals) + " " + FormatValue(x, decimals) + " " + FormatValue(y, decimals) + ")\" ";
-        s += "font-family=\"" + FontToFontFamily(vsFont[0]) + "\" ";
-        s += "font-size=\"" + FormatValue(size, 0) + "pt\" ";
-        s += "fill=\"" + color + "\">\n";
+        w << "<text y=\""; w.Num(y, decimals) << "\" transform=\"rotate(";
+        w.Num(rotation, decimals) << ' '; w.Num(x, decimals) << ' '; w.Num(y, decimals) << ")\" ";
+        WriteFontAttrs(w, FontToFontFamily(vsFont[0]), size, 0, color);
+        w << ">\n";
         for (size_t i=0; i<vsText.size(); i++) {
-            s += "      <tspan x=\"" + FormatValue(x, decimals) + "\" dy=\"" + FormatValue(((i>0)*1.4), decimals) + "em\">";
-            s += TextToEntity(vsText[i]) + "</tspan>\n";
+            w << "      <tspan x=\""; w.Num(x, decimals) << "\" dy=\""; w.Num(((i>0)*1.4), decimals) << "em\">";
+            w.Text(vsText[i]) << "</tspan>\n";
         }
-        s += "      </text>";
-        return s;
+        w << "      </text>";
     }
     else {
         // einzeiligen Text behandeln wir separat:
-        std::string s = "<text transform=\"translate(" ;
+        w << "<text transform=\"translate(" ;
         //
-        s += FormatValue(x, decimals) + ", " + FormatValue(y, decimals) + ")";
-        if (rotation != 0.0) { s += " rotate(" + FormatValue(rotation, decimals) + ")"; }
-        s += "\" ";
+        w.Num(x, decimals) << ", "; w.Num(y, decimals) << ')';
+        if (rotation != 0.0) { w << " rotate("; w.Num(rotation, decimals) << ')'; }
+        w << "\" ";
         // wir nutzen hier generische Schriftfamilien!!!
-        s += "font-family=\"" + FontToFontFamily(vsFont[0]) + "\" ";
-        s += "font-size=\"" + FormatValue(size, decimals) + "pt\" ";
-        s += "fill=\"" + color + "\">";
-        s += TextToEntity(text) + "</text>";
-        return s;
+        WriteFontAttrs(w, FontToFontFamily(vsFont[0]), size, decimals, color);
+        w << ">";
+        w.Text(text) << "</text>";
     }
 }
 // ---
@@ -778,19 +1163,10 @@ void ElmtText::CreateFontString(void)
 //
 //--- implementation of class "ElmtArc" ----------------------------------------
 //
-void ElmtArc::Flip(void)
-{// vertikale Spiegelung = Flip und normalisieren
-    y = ((-1.0) * y) - height;
-    start = (-1.0) * start;
-    angle = (-1.0) * angle;
-    Normalize();
-}
-// ---
-void ElmtArc::Mirror(void)
-{// horizontale Spiegelung = Mirror und normalisieren
-    x = ((-1.0) * x) - width;
-    start = 180 - start;
-    angle = (-1) * angle;
+void ElmtArc::Transform(const AffineTransform& t)
+{// Position, Größe und Winkel in einem Schritt, dann normalisieren
+    t.ApplyToBox(x, y, width, height);
+    t.ApplyToArc(start, angle);
     Normalize();
 }
 // ---
@@ -824,29 +1200,59 @@ void ElmtArc::SetData(const double& X, const double& Y,
 //---
 void ElmtArc::ReadFromPugiNode(pugi::xml_node& node)
 {
-    ReadPosition(node);
-    ReadSize(node);
-    start     = node.attribute("start").as_double();
-    angle     = node.attribute("angle").as_double();
-    antialias = node.attribute("antialias").as_bool();
-    style     = node.attribute("style").as_string();
+    x         = 0.0;
+    y         = 0.0;
+    start     = 0.0;
+    angle     = 0.0;
+    antialias = false;
+    style     = "";
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadPositionAttr(id, attr) || ReadSizeAttr(id, attr)) return;
+        switch (id) {
+            case Attr::start:     start     = ParseDouble(attr.value()); break;
+            case Attr::angle:     angle     = ParseDouble(attr.value()); break;
+            case Attr::antialias: antialias = ParseBool(attr.value());   break;
+            case Attr::style:     style     = attr.value();              break;
+            default: break;
+        }
+    });
+    ReadSizeDone(node);
 
     Normalize();
-    DetermineMinMax();
 }
 // ---
 void ElmtArc::DetermineMinMax(){
-      MinX =  1e99;
-      MaxX = -1e99;
-      MinY =  1e99;
-      MaxY = -1e99;
-    // calculate points on ellipse-circumference:
-    // x = a ⋅ cos(t)
-    // y = b ⋅ sin(t)
-    // with t = 0 .. 2*pi = ([0 .. 360]/360)*2*pi
-    for (int i = (int)round(start); i <= (int)round((start + angle)); i++){
-        double xx = x + (width / 2.0) * (1 + cos(toRad<double>(i)));
-        double yy = y + (height / 2.0) * (1 - sin(toRad<double>(i)));
+    const double key[6] = { x, y, width, height, start, angle };
+    if (std::equal(key, key + 6, MinMaxFor))
+        return;  // nothing changed
+    std::copy(key, key + 6, MinMaxFor);
+    // points on ellipse-circumference:
+    // x = x0 + a ⋅ (1 + cos(t))
+    // y = y0 + b ⋅ (1 - sin(t))
+    // the extreme values are the start- and end-point and all points at
+    // 0°, 90°, 180° and 270° in between - no need to walk through all angles
+    const double rx = width  / 2.0;
+    const double ry = height / 2.0;
+    const double t0 = start;
+    const double t1 = start + angle;
+    double xx = x + rx * (1 + cos(toRad<double>(t0)));
+    double yy = y + ry * (1 - sin(toRad<double>(t0)));
+    MinX = MaxX = xx;
+    MinY = MaxY = yy;
+    xx = x + rx * (1 + cos(toRad<double>(t1)));
+    yy = y + ry * (1 - sin(toRad<double>(t1)));
+    MinX = std::min(MinX, xx);
+    MaxX = std::max(MaxX, xx);
+    MinY = std::min(MinY, yy);
+    MaxY = std::max(MaxY, yy);
+    // exact values for the axes: cos and sin are 0, 1 or -1 there; width
+    // and height may be negative, so every point goes through min and max
+    static constexpr double cosAxis[4] = { 1.0, 0.0, -1.0,  0.0 };
+    static constexpr double sinAxis[4] = { 0.0, 1.0,  0.0, -1.0 };
+    for (int64_t k = (int64_t)std::ceil(t0 / 90.0); k <= (int64_t)std::floor(t1 / 90.0); k++) {
+        const int q = (int)(((k % 4) + 4) % 4);  // 0°, 90°, 180°, 270°
+        xx = x + rx * (1 + cosAxis[q]);
+        yy = y + ry * (1 - sinAxis[q]);
         MinX = std::min(MinX, xx);
         MaxX = std::max(MaxX, xx);
         MinY = std::min(MinY, yy);
@@ -854,47 +1260,41 @@ void ElmtArc::DetermineMinMax(){
     }
 }
 // ---
+static constexpr Attr OrderArc[] = {
+    Attr::x, Attr::y, Attr::z, Attr::width, Attr::height,
+    Attr::start, Attr::angle, Attr::style, Attr::antialias
+};
+// ---
 void ElmtArc::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
 {   // sort attributes:
-    WritePosition(node, decimals);
-    WriteSize(node, decimals);
-    node.remove_attribute("start");
-    node.append_attribute("start").set_value(FormatValue(start, 0));
-    node.remove_attribute("angle");
-    node.append_attribute("angle").set_value(FormatValue(angle, 0));
-    node.remove_attribute("style");
-    node.append_attribute("style").set_value(style);
-    node.remove_attribute("antialias");
-    node.append_attribute("antialias").set_value(antialias);
+    AttrWriter w(node, OrderArc);
+    WritePosition(w, decimals);
+    WriteSize(w, decimals);
+    w.Set(Attr::start, start, 0);
+    w.Set(Attr::angle, angle, 0);
+    w.Set(Attr::style, style);
+    w.Set(Attr::antialias, antialias);
+    w.Commit();
 }
 // ---
-void ElmtArc::Rot90(void)
+void ElmtArc::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
-    start += 270.0;
-    Normalize();
-    RotPos90(x, y, width, height);
-    SwapWidhHeight();
-}
-// ---
-std::string ElmtArc::AsSVGstring(const size_t& decimals)
-{
-    std::string s = "<path d=\"M ";
+    w << "<path d=\"M ";
     // Punkte berechnen und in String einfügen...
     // Startpunkt:
     double sx = x + (width / 2.0) * (1 + cos(toRad<double>(start)));
     double sy = y + (height / 2.0) * (1 - sin(toRad<double>(start)));
-    s += FormatValue(sx, decimals) + " " + FormatValue(sy, decimals);
+    w.Num(sx, decimals) << ' '; w.Num(sy, decimals);
     // Angaben für RadiusX, RadiusY, Rotation, Weg und Drehsinn:
-    s += " A " + FormatValue(width/2, decimals) + " " + FormatValue(height/2, decimals) + " 0 ";
-    ((angle <= 180.0) ? (s += "0") : (s += "1"));
-    s += " 0 ";
+    w << " A "; w.Num(width/2, decimals) << ' '; w.Num(height/2, decimals) << " 0 ";
+    w << ((angle <= 180.0) ? '0' : '1');
+    w << " 0 ";
     // Endpunkt:
     double ex = x + (width / 2.0) * (1 + cos(toRad<double>(start+angle)));
     double ey = y + (height / 2.0) * (1 - sin(toRad<double>(start+angle)));
-    s += FormatValue(ex, decimals) + " " + FormatValue(ey, decimals) + "\" ";
+    w.Num(ex, decimals) << ' '; w.Num(ey, decimals) << "\" ";
     //
-    s += StyleAsSVGstring(decimals);
-    return s + "/>";
+    w.Attrs(StyleAsSVGstring(decimals)) << "/>";
 }
 //
 //--- END - implementation of class "ElmtArc" ----------------------------------
@@ -907,52 +1307,68 @@ std::string ElmtArc::AsSVGstring(const size_t& decimals)
 //
 bool ElmtPolygon::ReadFromPugiNode(pugi::xml_node& node)
 {
-    if (node.attribute("closed"))
-        closed    = node.attribute("closed").as_bool();
-    antialias = node.attribute("antialias").as_bool();
-    style     = node.attribute("style").as_string();
-    // insert values in map to automatically sort:
-    std::map<uint64_t, double> valX;
-    std::map<uint64_t, double> valY;
-    uint64_t maxIX = 0; // max. Index for X
-    uint64_t maxIY = 0; // max. Index for Y
-    // walk through the attributes to read all points:
-    for (pugi::xml_attribute attr: node.attributes()) {
-        if (attr.name()[0]=='x') {
-            std::string str = attr.name();
-            str.erase(0, 1);
-            if (((std::string)attr.as_string() == "nan") || (!(std::isfinite(attr.as_double())))) {
-                std::cerr << " * * * Polygon-Point with invalid value!\n";
-            } else {
-                if ((uint64_t)std::stoi(str) > maxIX) { maxIX = std::stoi(str); }
-                valX[std::stoi(str)] = attr.as_double();
-            }
-            if (_DEBUG_) Write();
+    antialias = false;
+    style     = "";
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        switch (id) {
+            case Attr::closed:    closed    = ParseBool(attr.value()); break;
+            case Attr::antialias: antialias = ParseBool(attr.value()); break;
+            case Attr::style:     style     = attr.value();            break;
+            default: break;
         }
-        if (attr.name()[0]=='y') {
-            std::string str = attr.name();
-            str.erase(0, 1);
-            if (((std::string)attr.as_string() == "nan") || (!(std::isfinite(attr.as_double())))) {
-                std::cerr << " * * * Polygon-Point with invalid value!\n";
+    });
+    // every point needs "x<n>" and "y<n>": the highest possible index is
+    // half the number of attributes --> pre-size the vector with it
+    size_t nAttr = 0;
+    for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute())
+        nAttr++;
+    const uint64_t maxIndex = nAttr / 2;
+    polygon.assign(maxIndex, PolyPoint(0, std::nan(""), std::nan("")));
+    std::vector<uint8_t> present(maxIndex, 0);  // bit 0: x, bit 1: y
+    uint64_t nX = 0, nY = 0;                    // number of x- and y-values
+    uint64_t maxIX = 0, maxIY = 0;              // max. Index for X and Y
+    bool xIndexOK = true;
+    // walk through the attributes to read all points:
+    for (pugi::xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute()) {
+        const char* name = attr.name();
+        if ((name[0] != 'x') && (name[0] != 'y'))
+            continue;
+        const bool  xIsX = (name[0] == 'x');
+        const double val = ParseDouble(attr.value());
+        if (!(std::isfinite(val))) {
+            std::cerr << " * * * Polygon-Point with invalid value!\n";
+        } else {
+            // like "std::stoi": digits after "x"/"y", the rest is ignored
+            uint64_t idx = 0;
+            std::from_chars(name + 1, name + strlen(name), idx);
+            if ((idx == 0) || (idx > maxIndex)) {
+                xIndexOK = false;  // no consistent numbering possible
             } else {
-                if ((uint64_t)std::stoi(str) > maxIY) { maxIY = std::stoi(str); }
-                valY[std::stoi(str)] = attr.as_double();
+                const uint8_t bit = xIsX ? 1 : 2;
+                PolyPoint& pt = polygon[idx - 1];
+                pt.i = idx;
+                if (xIsX) pt.x = val; else pt.y = val;
+                if ((present[idx - 1] & bit) == 0) {
+                    present[idx - 1] |= bit;
+                    if (xIsX) { nX++; maxIX = std::max(maxIX, idx); }
+                    else      { nY++; maxIY = std::max(maxIY, idx); }
+                }
             }
-            if (_DEBUG_) Write();
         }
+        if (_DEBUG_) Write();
     } // for (pugi::xml_attribute ...
-    if (    (valX.size() == valY.size())     // beide maps müssen gleich groß sein
-         && (valX.size() >= 2)               // Polygon muss mehr als einen Punkt haben
-         && (valX.find(valX.size())->first == maxIX)  // höchster Index und Größe stimmen überein
-         && (valY.find(valY.size())->first == maxIY)  // höchster Index und Größe stimmen überein
+    if (    xIndexOK
+         && (nX == nY)       // gleich viele x- und y-Werte
+         && (nX >= 2)        // Polygon muss mehr als einen Punkt haben
+         && (maxIX == nX)    // höchster Index und Anzahl stimmen überein
+         && (maxIY == nY)    // höchster Index und Anzahl stimmen überein
         )
     {
-        // umkopieren in vector of PolyPoint:
-        for (uint64_t i=0; i<valX.size(); i++) {
-            polygon.push_back(PolyPoint(i+1, valX.at(i+1), valY.at(i+1)));
-        }
+        // the indices are unique --> "1" to "n" are all there
+        polygon.erase(polygon.begin() + nX, polygon.end());
         return true;
     } else {
+        polygon.clear();
         std::cerr << "Polygon not konsistent! \n";
         return false;
     }
@@ -960,34 +1376,26 @@ bool ElmtPolygon::ReadFromPugiNode(pugi::xml_node& node)
     return CheckIndex(node.name());
 }
 // ---
+static constexpr Attr OrderPolygon[] = {
+    Attr::points, Attr::closed, Attr::antialias, Attr::style
+};
+// ---
 void ElmtPolygon::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
 {   // wir sortieren die Attribute
+    AttrWriter w(node, OrderPolygon);
     // zuerst sind die Polygon-Punkte dran:
-    for (const auto &pt : polygon) {
-        std::string s = "";
-        s = "x" + std::to_string(pt.i);
-        node.remove_attribute(s);   // to sort the polygon-points...
-        node.append_attribute(s).set_value(FormatValue(pt.x, decimals));
-        s = "y" + std::to_string(pt.i);
-        node.remove_attribute(s);   // to sort the polygon-points...
-        node.append_attribute(s).set_value(FormatValue(pt.y, decimals));
-    }
+    w.Points(polygon, decimals);
     // dann die sonstigen Eigenschaften des Polygons:
-    if (node.attribute("closed"))
-        node.remove_attribute("closed");
     // "closed" ist nur drin, wenn "false":
     if (closed == false)
-        node.append_attribute("closed").set_value(closed);
+        w.Set(Attr::closed, closed);
+    else
+        w.Remove(Attr::closed);
     // antialias kommt dazu?
-    if (node.attribute("antialias")) {
-        node.remove_attribute("antialias");
-        node.append_attribute("antialias").set_value(antialias);
-    }
+    w.SetIfPresent(Attr::antialias, antialias);
     // einen Style hat das Polygon auch:
-    if (node.attribute("style")) {
-        node.remove_attribute("style");
-        node.append_attribute("style").set_value(style);
-    }
+    w.SetIfPresent(Attr::style, style);
+    w.Commit();
 }
 // ---
 bool ElmtPolygon::CheckIndex(const std::string sType){
@@ -1011,58 +1419,71 @@ bool ElmtPolygon::CheckIndex(const std::string sType){
    return true;
 }
 // ---
-void ElmtPolygon::Flip(void)
-{// vertikale Spiegelung = Flip
+void ElmtPolygon::Transform(const AffineTransform& t)
+{// alle Punkte in einem Durchgang - und dabei die Bounding-Box bestimmen
+    MinX =  1e99;
+    MaxX = -1e99;
+    MinY =  1e99;
+    MaxY = -1e99;
     for (auto &pt : polygon) {
-        pt.y *= (-1);
+        t.Apply(pt.x, pt.y);
+        MinX = std::min(MinX, pt.x);
+        MaxX = std::max(MaxX, pt.x);
+        MinY = std::min(MinY, pt.y);
+        MaxY = std::max(MaxY, pt.y);
     }
 }
 // ---
-void ElmtPolygon::Mirror(void)
-{// horizontale Spiegelung = Mirror
-    for (auto &pt : polygon) {
-        pt.x *= (-1);
-    }
+size_t ElmtPolygon::GatherPoints(CoordBuffer& buf) const
+{
+    const size_t offset = buf.Size();
+    for (const auto &pt : polygon)
+        buf.Append(pt.x, pt.y);
+    return offset;
 }
 // ---
-void ElmtPolygon::Rot90(void)
-{// drehen um 90° im Uhrzeigersinn
-    for (auto &pt : polygon) {
-        RotPoint90(pt.x, pt.y);
-    }
+void ElmtPolygon::ScatterPoints(const CoordBuffer& buf, const size_t offset)
+{// the points are transformed already: only copy back - and the bounding-box
+    const size_t n = polygon.size();
+    for (size_t i = 0; i < n; i++) {
+        polygon[i].x = buf.x[offset + i];
+        polygon[i].y = buf.y[offset + i];
+    }
+    MinX =  1e99;
+    MaxX = -1e99;
+    MinY =  1e99;
+    MaxY = -1e99;
+    MinMaxValues(buf.x.data() + offset, n, MinX, MaxX);
+    MinMaxValues(buf.y.data() + offset, n, MinY, MaxY);
 }
 // ---
-void ElmtPolygon::Scale(const double& factX, const double& factY)
+void ElmtPolygon::DetermineMinMax()
 {
-    for (auto &pt: polygon) {
-        pt.x *= factX;
-        pt.y *= factY;
-    }
-}
-// ---
-void ElmtPolygon::Move(const double& dx, const double& dy)
-{   // add the delta-values to all X- and Y-values
-    for (auto &pt: polygon) {
-        pt.x += dx;
-        pt.y += dy;
+    MinX =  1e99;
+    MaxX = -1e99;
+    MinY =  1e99;
+    MaxY = -1e99;
+    for (const auto &pt : polygon) {
+        MinX = std::min(MinX, pt.x);
+        MaxX = std::max(MaxX, pt.x);
+        MinY = std::min(MinY, pt.y);
+        MaxY = std::max(MaxY, pt.y);
     }
 }
 // ---
-std::string ElmtPolygon::AsSVGstring(const size_t& decimals)
+void ElmtPolygon::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
-    if (polygon.size() == 0) return "<polygon />";
-    std::string s = "<polygon points=\"";
-    if (closed == false) s = "<polyline points=\"";
+    if (polygon.size() == 0) { w << "<polygon />"; return; }
+    w << ((closed == false) ? "<polyline points=\"" : "<polygon points=\"");
     //
-    for (auto &pt: polygon) {
-        s += FormatValue(pt.x, decimals) + ",";
-        s += FormatValue(pt.y, decimals) + " ";
+    for (size_t i = 0; i < polygon.size(); i++) {
+        if (i > 0) w << ' ';
+        w.Num(polygon[i].x, decimals) << ',';
+        w.Num(polygon[i].y, decimals);
     }
-    s[s.length()-1] = '\"';
-    s += " ";
+    w << "\" ";
     //
-    s += StyleAsSVGstring(decimals);
-    return s + "/>";
+    w.Attrs(StyleAsSVGstring(decimals)) << "/>";
 }
 // ---
 void ElmtPolygon::CleanUp(pugi::xml_node& node, const double& epsilon)
@@ -1105,6 +1526,7 @@ void ElmtPolygon::CleanUp(pugi::xml_node& node, const double& epsilon)
         for (uint64_t i=0; i<polygon.size(); i++) {
             polygon[i].i = i + 1;
         }
+        DetermineMinMax();
     }
 }
 //
@@ -1120,43 +1542,45 @@ void ElmtPolygon::CleanUp(pugi::xml_node& node, const double& epsilon)
 //
 void ElmtEllipse::ReadFromPugiNode(pugi::xml_node& node)
 {
-    ReadPosition(node);
-    ReadSize(node);
-    antialias = node.attribute("antialias").as_bool();
-    style     = node.attribute("style").as_string();
+    x         = 0.0;
+    y         = 0.0;
+    antialias = false;
+    style     = "";
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadPositionAttr(id, attr) || ReadSizeAttr(id, attr)) return;
+        switch (id) {
+            case Attr::antialias: antialias = ParseBool(attr.value()); break;
+            case Attr::style:     style     = attr.value();            break;
+            default: break;
+        }
+    });
+    ReadSizeDone(node);
 }
 // ---
+static constexpr Attr OrderEllipse[] = {
+    Attr::x, Attr::y, Attr::z, Attr::width, Attr::height, Attr::style, Attr::antialias
+};
+// ---
 void ElmtEllipse::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
 {   // sort attributes:
-    WritePosition(node, decimals);
-    WriteSize(node, decimals);
-    if (node.attribute("style")){
-        node.remove_attribute("style");
-        node.append_attribute("style").set_value(style);
-    }
-    if (node.attribute("antialias")){
-        node.remove_attribute("antialias");
-        node.append_attribute("antialias").set_value(antialias);
-    }
-}
-// ---
-void ElmtEllipse::Rot90(void)
-{
-    RotPos90(x, y, width, height);
-    SwapWidhHeight();
+    AttrWriter w(node, OrderEllipse);
+    WritePosition(w, decimals);
+    WriteSize(w, decimals);
+    w.SetIfPresent(Attr::style, style);
+    w.SetIfPresent(Attr::antialias, antialias);
+    w.Commit();
 }
 // ---
-std::string ElmtEllipse::AsSVGstring(const size_t& decimals)
+void ElmtEllipse::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
-    std::string s = "<ellipse ";
+    w << "<ellipse ";
     //
-    s += "cx=\"" + FormatValue((x + width/2), decimals) + "\" ";
-    s += "cy=\"" + FormatValue((y + height/2), decimals) + "\" ";
-    s += "rx=\"" + FormatValue(width/2, decimals) + "\" ";
-    s += "ry=\"" + FormatValue(height/2, decimals) + "\" ";
+    w << "cx=\""; w.Num((x + width/2), decimals) << "\" ";
+    w << "cy=\""; w.Num((y + height/2), decimals) << "\" ";
+    w << "rx=\""; w.Num(width/2, decimals) << "\" ";
+    w << "ry=\""; w.Num(height/2, decimals) << "\" ";
     //
-    s += StyleAsSVGstring(decimals);
-    return s + "/>";
+    w.Attrs(StyleAsSVGstring(decimals)) << "/>";
 }
 //
 //--- END - implementation of class "ElmtEllipse" ------------------------------
@@ -1171,48 +1595,54 @@ std::string ElmtEllipse::AsSVGstring(const size_t& decimals)
 //
 void ElmtRect::ReadFromPugiNode(pugi::xml_node& node)
 {
-    ReadPosition(node);
-    rx        = node.attribute("rx").as_double();
-    ry        = node.attribute("ry").as_double();
-    ReadSize(node);
-    antialias = node.attribute("antialias").as_bool();
-    style     = node.attribute("style").as_string();
+    x         = 0.0;
+    y         = 0.0;
+    rx        = 0.0;
+    ry        = 0.0;
+    antialias = false;
+    style     = "";
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadPositionAttr(id, attr) || ReadSizeAttr(id, attr)) return;
+        switch (id) {
+            case Attr::rx:        rx        = ParseDouble(attr.value()); break;
+            case Attr::ry:        ry        = ParseDouble(attr.value()); break;
+            case Attr::antialias: antialias = ParseBool(attr.value());   break;
+            case Attr::style:     style     = attr.value();              break;
+            default: break;
+        }
+    });
+    ReadSizeDone(node);
 }
 // ---
-void ElmtRect::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
-{
-    WritePosition(node, decimals);
-    WriteSize(node, decimals);
-    node.remove_attribute("rx");
-    node.append_attribute("rx").set_value(FormatValue(rx, decimals));
-    node.remove_attribute("ry");
-    node.append_attribute("ry").set_value(FormatValue(ry, decimals));
-    node.remove_attribute("style");
-    node.append_attribute("style").set_value(style);
-    node.remove_attribute("antialias");
-    node.append_attribute("antialias").set_value(antialias);
-}
+static constexpr Attr OrderRect[] = {
+    Attr::x, Attr::y, Attr::z, Attr::width, Attr::height,
+    Attr::rx, Attr::ry, Attr::style, Attr::antialias
+};
 // ---
-void ElmtRect::Rot90(void)
+void ElmtRect::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
 {
-    RotPos90(x, y, width, height);
-    std::swap(width, height);
-    std::swap(rx, ry);
+    AttrWriter w(node, OrderRect);
+    WritePosition(w, decimals);
+    WriteSize(w, decimals);
+    w.Set(Attr::rx, rx, decimals);
+    w.Set(Attr::ry, ry, decimals);
+    w.Set(Attr::style, style);
+    w.Set(Attr::antialias, antialias);
+    w.Commit();
 }
 // ---
-std::string ElmtRect::AsSVGstring(const size_t& decimals)
+void ElmtRect::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
-    std::string s = "<rect ";
+    w << "<rect ";
     //
-    s += "x=\"" + FormatValue(x, decimals) + "\" ";
-    s += "y=\"" + FormatValue(y, decimals) + "\" ";
-    s += "width=\"" + FormatValue(width, decimals) + "\" ";
-    s += "height=\"" + FormatValue(height, decimals) + "\" ";
-    if (rx > 0.0) s += "rx=\"" + FormatValue(rx, decimals) + "\" ";
-    if (ry > 0.0) s += "ry=\"" + FormatValue(ry, decimals) + "\" ";
+    w << "x=\""; w.Num(x, decimals) << "\" ";
+    w << "y=\""; w.Num(y, decimals) << "\" ";
+    w << "width=\""; w.Num(width, decimals) << "\" ";
+    w << "height=\""; w.Num(height, decimals) << "\" ";
+    if (rx > 0.0) { w << "rx=\""; w.Num(rx, decimals) << "\" "; }
+    if (ry > 0.0) { w << "ry=\""; w.Num(ry, decimals) << "\" "; }
     //
-    s += StyleAsSVGstring(decimals);
-    return s + "/>";
+    w.Attrs(StyleAsSVGstring(decimals)) << "/>";
 }
 //
 //--- END - implementation of class "ElmtRect" ---------------------------------
@@ -1226,64 +1656,140 @@ std::string ElmtRect::AsSVGstring(const size_t& decimals)
 //
 bool ElmtLine::ReadFromPugiNode(pugi::xml_node& node)
 {
-    length1   = node.attribute("length1").as_double();
-    length2   = node.attribute("length2").as_double();
-    end1      = node.attribute("end1").as_string();
-    end2      = node.attribute("end2").as_string();
-    antialias = node.attribute("antialias").as_bool();
-    style     = node.attribute("style").as_string();
+    length1   = 0.0;
+    length2   = 0.0;
+    end1      = "";
+    end2      = "";
+    antialias = false;
+    style     = "";
+    const char* pPoint[4] = {nullptr, nullptr, nullptr, nullptr};  // x1, y1, x2, y2
+    ForEachAttr(node, [&](const Attr id, const pugi::xml_attribute& attr) {
+        switch (id) {
+            case Attr::length1:   length1   = ParseDouble(attr.value()); break;
+            case Attr::length2:   length2   = ParseDouble(attr.value()); break;
+            case Attr::end1:      end1      = attr.value();              break;
+            case Attr::end2:      end2      = attr.value();              break;
+            case Attr::antialias: antialias = ParseBool(attr.value());   break;
+            case Attr::style:     style     = attr.value();              break;
+            case Attr::x1:        pPoint[0] = attr.value();              break;
+            case Attr::y1:        pPoint[1] = attr.value();              break;
+            case Attr::x2:        pPoint[2] = attr.value();              break;
+            case Attr::y2:        pPoint[3] = attr.value();              break;
+            default: break;
+        }
+    });
     // Gibt es die Attribute überhaupt???
-    if ((node.attribute("x1") && node.attribute("x2") &&
-         node.attribute("y1") && node.attribute("y2"))   == false) {
+    if ((pPoint[0] && pPoint[2] && pPoint[1] && pPoint[3]) == false) {
         std::cerr << "Remove incomplete " << node.name() << "\n";
         return false;
         }
     // die Daten in den Vector:
-    polygon.push_back(PolyPoint(1, node.attribute("x1").as_double(), node.attribute("y1").as_double()));
-    polygon.push_back(PolyPoint(2, node.attribute("x2").as_double(), node.attribute("y2").as_double()));
+    polygon.push_back(PolyPoint(1, ParseDouble(pPoint[0]), ParseDouble(pPoint[1])));
+    polygon.push_back(PolyPoint(2, ParseDouble(pPoint[2]), ParseDouble(pPoint[3])));
     return CheckIndex(node.name());
 }
 // ---
+static constexpr Attr OrderLine[] = {
+    Attr::x1, Attr::y1, Attr::x2, Attr::y2, Attr::end1, Attr::end2,
+    Attr::length1, Attr::length2, Attr::style, Attr::antialias
+};
+// ---
 void ElmtLine::WriteToPugiNode(pugi::xml_node& node, const size_t& decimals)
 {   // sort attributes
-    node.remove_attribute("x1");
-    node.append_attribute("x1").set_value(FormatValue(polygon[0].x, decimals));
-    node.remove_attribute("y1");
-    node.append_attribute("y1").set_value(FormatValue(polygon[0].y, decimals));
-    node.remove_attribute("x2");
-    node.append_attribute("x2").set_value(FormatValue(polygon[1].x, decimals));
-    node.remove_attribute("y2");
-    node.append_attribute("y2").set_value(FormatValue(polygon[1].y, decimals));
-    node.remove_attribute("end1");
-    node.append_attribute("end1").set_value(end1);
-    node.remove_attribute("end2");
-    node.append_attribute("end2").set_value(end2);
-    node.remove_attribute("length1");
-    node.append_attribute("length1").set_value(FormatValue(length1, decimals));
-    node.remove_attribute("length2");
-    node.append_attribute("length2").set_value(FormatValue(length2, decimals));
-    node.remove_attribute("style");
-    node.append_attribute("style").set_value(style);
-    node.remove_attribute("antialias");
-    node.append_attribute("antialias").set_value(antialias);
-}
-// ---
-std::string ElmtLine::AsSVGstring(const size_t& decimals)
-{
-    if (polygon.size() == 0) return "<line />";
+    AttrWriter w(node, OrderLine);
+    w.Set(Attr::x1, polygon[0].x, decimals);
+    w.Set(Attr::y1, polygon[0].y, decimals);
+    w.Set(Attr::x2, polygon[1].x, decimals);
+    w.Set(Attr::y2, polygon[1].y, decimals);
+    w.Set(Attr::end1, end1);
+    w.Set(Attr::end2, end2);
+    w.Set(Attr::length1, length1, decimals);
+    w.Set(Attr::length2, length2, decimals);
+    w.Set(Attr::style, style);
+    w.Set(Attr::antialias, antialias);
+    w.Commit();
+}
+// ---
+// the real line is shorter than the element-line: that is the space for the end
+static double EndOffset(const std::string& end, const double len, const double lwidth)
+{
+    if (end == "simple")   return (lwidth / 2.0);
+    if (end == "triangle") return len + (lwidth / 2.0);
+    if ((end == "circle") || (end == "diamond"))
+        return (len * 2) + (lwidth / 2.0);
+    return 0.0;
+}
+// ---
+// "--svg-markers": the geometry of an end like in "ElmtLine::WriteSVG", but
+// around the end-point of the element-line; "refX" is the end of the real line
+// ("" for "none" or an unknown end)
+static std::string EndMarker(const std::string& end, const double len, const bool xStart,
+                             const double offset, std::string_view attrs, const size_t& decimals)
+{
+    if ((end != "simple") && (end != "triangle") && (end != "circle") && (end != "diamond"))
+        return "";
+    const double sgn = (xStart ? 1.0 : -1.0);
+    const std::string x  = FormatValue((sgn * len), decimals);   // towards the line
+    const std::string yp = FormatValue(len, decimals);
+    const std::string ym = FormatValue(-len, decimals);
+    std::string s = "markerUnits=\"userSpaceOnUse\" refX=\"" + FormatValue((sgn * offset) + 0.0, decimals)
+                  + "\" refY=\"0\" orient=\"auto\" overflow=\"visible\" stroke-linecap=\"square\" ";
+    s += attrs.substr(0, attrs.find_last_not_of(' ') + 1);
+    s += ">\n";
+    if      (end == "simple")
+        s += "      <polyline points=\"" + x + "," + yp + " 0,0 " + x + "," + ym + "\" />\n";
+    else if (end == "triangle")
+        s += "      <polygon points=\"" + x + "," + yp + " 0,0 " + x + "," + ym + "\" />\n";
+    else if (end == "circle")
+        s += "      <ellipse cx=\"" + x + "\" cy=\"0\" rx=\"" + yp + "\" ry=\"" + yp + "\" />\n";
+    else if (end == "diamond")
+        s += "      <polygon points=\"0,0 " + x + "," + yp + " " + FormatValue((sgn * 2 * len), decimals)
+                                        + ",0 " + x + "," + ym + "\" />\n";
+    return s;
+}
+// ---
+void ElmtLine::WriteSVG(SvgWriter& w, const size_t& decimals)
+{
+    if (polygon.size() == 0) { w << "<line />"; return; }
+
+    // "--svg-markers": a single line in absolute coordinates with references to
+    // the ends - only if the ends leave something of the line
+    if (w.HasMarkers()) {
+        const std::string& attrs = StyleAsSVGstring(decimals);
+        const double llength = GetLength();
+        const double lwidth  = GetLineWidth();
+        const double x1      = EndOffset(end1, length1, lwidth);
+        const double x2      = llength - EndOffset(end2, length2, lwidth);
+        if ((llength > 0.0) && (x1 <= x2)) {
+            const double dx = (polygon[1].x - polygon[0].x) / llength;
+            const double dy = (polygon[1].y - polygon[0].y) / llength;
+            w << "<line x1=\""; w.Num(polygon[0].x + x1 * dx, decimals) << "\" y1=\"";
+                                w.Num(polygon[0].y + x1 * dy, decimals) << "\" x2=\"";
+                                w.Num(polygon[0].x + x2 * dx, decimals) << "\" y2=\"";
+                                w.Num(polygon[0].y + x2 * dy, decimals) << "\" ";
+            w.Attrs(attrs);
+            const std::string sStart = EndMarker(end1, length1, true,  x1, attrs, decimals);
+            const std::string sEnd   = EndMarker(end2, length2, false, llength - x2, attrs, decimals);
+            if (sStart.length() > 0) w.MarkerRef("marker-start", sStart);
+            if (sEnd.length()   > 0) w.MarkerRef("marker-end",   sEnd);
+            w << "/>";
+            return;
+        }
+    }
 
     // Hier müssen die Enden mit verwurstet werden: Alles in eine Gruppierung
-    std::string s = "<g ";
+    w << "<g ";
     // hier kommen die Linienattribute mit rein
-    s += StyleAsSVGstring(decimals);
+    w.Attrs(StyleAsSVGstring(decimals));
     // Anfang auf x1|y1 verschieben:
-    s += "transform=\"translate(" + FormatValue(polygon[0].x, decimals) + ","
-                                  + FormatValue(polygon[0].y, decimals) + ")";
+    w << "transform=\"translate("; w.Num(polygon[0].x, decimals) << ',';
+                                   w.Num(polygon[0].y, decimals) << ')';
     // und falls die Linie eine Schräge ist, auch rotieren:
-    if ( (GetAngle() > 0.05) || (GetAngle() < -0.05))
-        s += " rotate(" + FormatValue(GetAngle(), decimals) + ")";
+    if ( (GetAngle() > 0.05) || (GetAngle() < -0.05)) {
+        w << " rotate("; w.Num(GetAngle(), decimals) << ')';
+    }
     // Gruppierungs-Anfang beenden:
-    s += "\" >\n";
+    w << "\" >\n";
     // wir bestimmen Anfang und Ende der realen Linie in Abhängigkeit der Enden:
     double llength = GetLength();
     double lwidth  = GetLineWidth();
@@ -1295,41 +1801,36 @@ std::string ElmtLine::AsSVGstring(const size_t& decimals)
     else if (end1 == "simple") {
             x1 += (lwidth / 2.0);
             // einfachen Pfeil (polyline) zeichnen
-            s += "      <polyline points=\"" + FormatValue(length1, decimals) + ","
-                                             + FormatValue(length1, decimals)
-                                             + " 0,0 "
-                                             + FormatValue(length1, decimals) + ","
-                                             + "-" + FormatValue(length1, decimals)
-                                             + "\" />\n";
+            w << "      <polyline points=\""; w.Num(length1, decimals) << ',';
+                                              w.Num(length1, decimals) << " 0,0 ";
+                                              w.Num(length1, decimals) << ",-";
+                                              w.Num(length1, decimals) << "\" />\n";
     }
     else if (end1 == "triangle") {
             x1 += length1 + (lwidth / 2.0);
             // dreieckigen Pfeil (polygon) zeichnen
-            s += "      <polygon points=\"" + FormatValue(length1, decimals) + ","
-                                            + FormatValue(length1, decimals)
-                                            + " 0,0 "
-                                            + FormatValue(length1, decimals) + ","
-                                            + "-" + FormatValue(length1, decimals)
-                                            + "\" />\n";
+            w << "      <polygon points=\""; w.Num(length1, decimals) << ',';
+                                             w.Num(length1, decimals) << " 0,0 ";
+                                             w.Num(length1, decimals) << ",-";
+                                             w.Num(length1, decimals) << "\" />\n";
     }
     else if (end1 == "circle") {
             x1 = (length1 * 2) + (lwidth / 2.0);
             // Kringel zeichnen
-            s += "      <ellipse cx=\"" + FormatValue(length1, decimals) + "\" cy=\"0\""
-                                      + " rx=\"" + FormatValue(length1, decimals) + "\""
-                                      + " ry=\"" + FormatValue(length1, decimals) + "\""
-                                      + " />\n";
+            w << "      <ellipse cx=\""; w.Num(length1, decimals) << "\" cy=\"0\"";
+            w << " rx=\""; w.Num(length1, decimals) << '"';
+            w << " ry=\""; w.Num(length1, decimals) << '"';
+            w << " />\n";
     }
     else if (end1 == "diamond") {
             x1 = (length1 * 2) + (lwidth / 2.0);
             // Karo zeichnen
-            s += "      <polygon points=\"0,0 "
-                                      + FormatValue( length1, decimals) + ","
-                                      + FormatValue(length1, decimals) + " "
-                                      + FormatValue((2 * length1), decimals) + ",0 "
-                                      + FormatValue( length1, decimals) + ","
-                                      + "-" + FormatValue(length1, decimals)
-                                      + "\" />\n";
+            w << "      <polygon points=\"0,0 ";
+            w.Num( length1, decimals) << ',';
+            w.Num(length1, decimals) << ' ';
+            w.Num((2 * length1), decimals) << ",0 ";
+            w.Num( length1, decimals) << ",-";
+            w.Num(length1, decimals) << "\" />\n";
     }
 
     // ... und nun das Ende der realen Linie bestimmen und die Enden zeichnen:
@@ -1339,51 +1840,46 @@ std::string ElmtLine::AsSVGstring(const size_t& decimals)
     else if (end2 == "simple") {
             x2 -= (lwidth / 2.0);
             // einfachen Pfeil (polyline) zeichnen
-            s += "      <polyline points=\"" + FormatValue((llength-length2), decimals) + ","
-                                             + FormatValue(length2, decimals) + " "
-                                             + FormatValue(llength, decimals) + ",0 "
-                                             + FormatValue((llength-length2), decimals) + ","
-                                             + "-" + FormatValue(length2, decimals)
-                                             + "\" />\n";
+            w << "      <polyline points=\""; w.Num((llength-length2), decimals) << ',';
+                                              w.Num(length2, decimals) << ' ';
+                                              w.Num(llength, decimals) << ",0 ";
+                                              w.Num((llength-length2), decimals) << ",-";
+                                              w.Num(length2, decimals) << "\" />\n";
     }
     else if (end2 == "triangle") {
             x2 -= (length2 + (lwidth / 2.0));
             // dreieckigen Pfeil (polygon) zeichnen
-            s += "      <polygon points=\"" + FormatValue(llength, decimals) + ",0 "
-                                            + FormatValue((llength-length2), decimals) + ","
-                                            + FormatValue(length2, decimals) + " "
-                                            + FormatValue((llength-length2), decimals) + ","
-                                            + "-" + FormatValue(length2, decimals)
-                                            + "\" />\n";
+            w << "      <polygon points=\""; w.Num(llength, decimals) << ",0 ";
+                                             w.Num((llength-length2), decimals) << ',';
+                                             w.Num(length2, decimals) << ' ';
+                                             w.Num((llength-length2), decimals) << ",-";
+                                             w.Num(length2, decimals) << "\" />\n";
     }
     else if (end2 == "circle") {
             x2 -= ((length2 * 2) + (lwidth / 2.0));
             // Kringel zeichnen
-            s += "      <ellipse cx=\"" + FormatValue((llength - length2), decimals) + "\" cy=\"0\""
-                                        + " rx=\"" + FormatValue(length2, decimals) + "\""
-                                        + " ry=\"" + FormatValue(length2, decimals) + "\""
-                                        + " />\n";
+            w << "      <ellipse cx=\""; w.Num((llength - length2), decimals) << "\" cy=\"0\"";
+            w << " rx=\""; w.Num(length2, decimals) << '"';
+            w << " ry=\""; w.Num(length2, decimals) << '"';
+            w << " />\n";
     }
     else if (end2 == "diamond") {
             x2 -= ((length2 * 2) + (lwidth / 2.0));
             // Karo zeichnen
-            s += "      <polygon points=\""
-                                      + FormatValue( llength, decimals) + ",0 "
-                                      + FormatValue((llength - length2), decimals) + ","
-                                      + FormatValue(length2, decimals) + " "
-                                      + FormatValue((llength - 2 * length2), decimals) + ",0 "
-                                      + FormatValue((llength - length2), decimals) + ","
-                                      + "-" + FormatValue(length2, decimals)
-                                      + "\" />\n";
+            w << "      <polygon points=\"";
+            w.Num( llength, decimals) << ",0 ";
+            w.Num((llength - length2), decimals) << ',';
+            w.Num(length2, decimals) << ' ';
+            w.Num((llength - 2 * length2), decimals) << ",0 ";
+            w.Num((llength - length2), decimals) << ",-";
+            w.Num(length2, decimals) << "\" />\n";
     }
 
     // nun noch die eigentliche Linie dazu:
-    s += "      <line x1=\"" + FormatValue(x1, decimals) + "\" y1=\"0\" x2=\""
-                             + FormatValue(x2, decimals) + "\" y2=\"0\" />\n";
+    w << "      <line x1=\""; w.Num(x1, decimals) << "\" y1=\"0\" x2=\"";
+                              w.Num(x2, decimals) << "\" y2=\"0\" />\n";
     // Gruppierung ist hier beendet:
-    s += "      </g>";
-    // und die Funktion auch!
-    return s;
+    w << "      </g>";
 }
 //
 //--- END - implementation of class "ElmtLine" ---------------------------------
@@ -1396,85 +1892,85 @@ std::string ElmtLine::AsSVGstring(const size_t& decimals)
 //
 void ElmtTerminal::ReadFromPugiNode(pugi::xml_node& node)
 {
-    ReadPosition(node);
-    orientation = node.attribute("orientation").as_string();
-    type        = node.attribute("type").as_string();
+    x           = 0.0;
+    y           = 0.0;
+    orientation = "";
+    type        = "";
+    name        = "";
+    uuid        = "";
+    ForEachAttr(node, [this](const Attr id, const pugi::xml_attribute& attr) {
+        if (ReadPositionAttr(id, attr)) return;
+        switch (id) {
+            case Attr::orientation: orientation = attr.value(); break;
+            case Attr::type:        type        = attr.value(); break;
+            case Attr::name:        name        = attr.value(); break;
+            case Attr::uuid:        uuid        = attr.value(); break;
+            default: break;
+        }
+    });
     if (type.length() == 0) { type = "Generic"; }
-    name        = node.attribute("name").as_string();
-    uuid        = node.attribute("uuid").as_string();
     if (uuid.length() != 38) {
-        uuid  = "{" + CreateUUID(false) + "}";
+        uuid  = CreateBracedUUID().c_str();
         node.remove_attribute("uuid");
         node.prepend_attribute("uuid").set_value(uuid);
     }
 }
 // ---
+static constexpr Attr OrderTerminal[] = {
+    Attr::name, Attr::x, Attr::y, Attr::z, Attr::orientation, Attr::type
+};
+// ---
 void ElmtTerminal::WriteToPugiNode(pugi::xml_node& node)
 {
-    // to achieve a constant order we need to remove and append attributes
-    if (node.attribute("uuid")) {
-        node.remove_attribute("uuid");
-        node.prepend_attribute("uuid").set_value(uuid);
+    // to achieve a constant order: "uuid" first, then the table
+    AttrWriter w(node, OrderTerminal, Attr::uuid);
+    if (w.Has(Attr::uuid)) {
+        w.Set(Attr::uuid, uuid);
         } else {
-        node.prepend_attribute("uuid").set_value(("{" + CreateUUID(false) + "}"));
+        w.Set(Attr::uuid, CreateBracedUUID().c_str());
         }
-    if (node.attribute("name")) {
-        node.remove_attribute("name");
-        node.append_attribute("name").set_value(name);
+    if (w.Has(Attr::name)) {
+        w.Set(Attr::name, name);
         } else {
-        node.append_attribute("name").set_value("");
+        w.Set(Attr::name, "");
         }
-    WritePosition(node, 0);
-    node.remove_attribute("orientation");
-    node.append_attribute("orientation").set_value(orientation);
-    if (node.attribute("type")) {
-        node.remove_attribute("type");
-        node.append_attribute("type").set_value(type);
+    WritePosition(w, 0);
+    w.Set(Attr::orientation, orientation);
+    if (w.Has(Attr::type)) {
+        w.Set(Attr::type, type);
         } else {
-        node.append_attribute("type").set_value("Generic");
+        w.Set(Attr::type, "Generic");
         }
+    w.Commit();
 }
 // ---
-void ElmtTerminal::Rot90(void){
-    RotPoint90(x, y);
-    switch (orientation[0]){
-    case 'n': orientation = "e"; break;
-    case 'e': orientation = "s"; break;
-    case 's': orientation = "w"; break;
-    case 'w': orientation = "n"; break;
+void ElmtTerminal::Transform(const AffineTransform& t){
+    t.Apply(x, y);
+    if (orientation.length() > 0) {
+        const char o = t.ApplyToOrientation(orientation[0]);
+        if (o != orientation[0]) orientation = std::string(1, o);
     }
 }
 // ---
-std::string ElmtTerminal::AsSVGstring(const size_t& decimals)
+void ElmtTerminal::WriteSVG(SvgWriter& w, const size_t& decimals)
 {
-    std::string s = "<use xlink:href=\"#terminal\" ";
+    w << "<use xlink:href=\"#terminal\" ";
     //
-    s += "x=\"" + FormatValue(x, 0) + "\" ";
-    s += "y=\"" + FormatValue(y, 0) + "\" ";
+    w << "x=\""; w.Num(x, 0) << "\" ";
+    w << "y=\""; w.Num(y, 0) << "\" ";
     // Fallunterscheidung "orientation":
-    if ( (orientation == "e") || (orientation == "E") ) {
-        s += "transform=\"rotate(90 ";
-        s += FormatValue(x, 0) + " ";
-        s += FormatValue(y, 0) + ")\" ";
-    }
-    else if ( (orientation == "s") || (orientation == "S") ) {
-        s += "transform=\"rotate(180 ";
-        s += FormatValue(x, 0) + " ";
-        s += FormatValue(y, 0) + ")\" ";
-    }
-    else if ( (orientation == "w") || (orientation == "W") ) {
-        s += "transform=\"rotate(270 ";
-        s += FormatValue(x, 0) + " ";
-        s += FormatValue(y, 0) + ")\" ";
-    }
-    else /* muss "n" oder "N" sein! */ {
-        s += ""; // keine Rotation!
-    }
-    //s += "type=\"" + type + "\" ";
-    //s += "name=\"" + name + "\" ";
-    //s += "uuid=\"" + uuid + "\" ";
+    const char* rot = nullptr;
+    if      ( (orientation == "e") || (orientation == "E") ) rot = "90 ";
+    else if ( (orientation == "s") || (orientation == "S") ) rot = "180 ";
+    else if ( (orientation == "w") || (orientation == "W") ) rot = "270 ";
+    /* sonst muss es "n" oder "N" sein: keine Rotation! */
+    if (rot != nullptr) {
+        w << "transform=\"rotate(" << rot;
+        w.Num(x, 0) << ' ';
+        w.Num(y, 0) << ")\" ";
+    }
     //
-    return s + "/>";
+    w << "/>";
 }
 //
 //--- END - implementation of class "ElmtTerminal" -----------------------------
@@ -1570,189 +2066,359 @@ double RectMinMax::angle(void){
 //
 
 
-void RotPos90(double& x, double& y, double& width, double& height){
-// Parameterübergabe als Referenz - dann werden direkt die Positionen überschrieben.
-// Fallunterscheidung, in welchem Quadranten des Koordinatensystems der Punkt liegt, ist nicht nötig
-    double xneu = (y + height) * (-1);
-    y = x;
-    x = xneu;
-}
 
-void RotPoint90(double& x, double& y){
-        double tmp = y;
-        y = x;
-        x = (-1) * tmp;
+
+//
+//--- implementation of class "AffineTransform" --------------------------------
+//
+// the new operation (a2 ... f2) is applied after the existing ones
+void AffineTransform::Append(const double a2, const double b2, const double c2,
+                             const double d2, const double e2, const double f2)
+{
+    const double na = a2 * a + b2 * c;
+    const double nb = a2 * b + b2 * d;
+    const double nc = c2 * a + d2 * c;
+    const double nd = c2 * b + d2 * d;
+    const double ne = a2 * e + b2 * f + e2;
+    const double nf = c2 * e + d2 * f + f2;
+    a = na; b = nb; c = nc; d = nd; e = ne; f = nf;
+    // e.g. two times 45°: rounding errors must not destroy a 90°-step
+    for (double* v : {&a, &b, &c, &d}) {
+        if (std::abs(*v) < 1e-12) *v = 0.0;
+    }
+}
+// ---
+void AffineTransform::Rotate(const double deg)
+{
+    double cs = std::cos(toRad<double>(deg));
+    double sn = std::sin(toRad<double>(deg));
+    // exact values for steps of 90°: no "6.12e-17" instead of "0"
+    const double q = std::fmod(deg, 360.0);
+    if      ((q ==   0.0))                   { cs =  1.0; sn =  0.0; }
+    else if ((q ==  90.0) || (q == -270.0)) { cs =  0.0; sn =  1.0; }
+    else if ((q == 180.0) || (q == -180.0)) { cs = -1.0; sn =  0.0; }
+    else if ((q == 270.0) || (q ==  -90.0)) { cs =  0.0; sn = -1.0; }
+    Append(cs, -sn, sn, cs, 0.0, 0.0);
+    rotation += deg;
+}
+// ---
+void AffineTransform::Scale(const double sx, const double sy)
+{
+    Append(sx, 0.0, 0.0, sy, 0.0, 0.0);
+    sizeFactor *= std::min(sx, sy);
 }
+// ---
+void AffineTransform::Apply(double& x, double& y) const
+{   // the zero-entries are skipped: same results as the single operations
+    const double nx = (b == 0.0) ? (a * x) : ((a == 0.0) ? (b * y) : (a * x + b * y));
+    const double ny = (c == 0.0) ? (d * y) : ((d == 0.0) ? (c * x) : (c * x + d * y));
+    x = (e == 0.0) ? nx : (nx + e);
+    y = (f == 0.0) ? ny : (ny + f);
+}
+// ---
+// for "--uuid-mode=hash": the same transformation gives the same string
+std::string AffineTransform::AsKey(void) const
+{
+    const double v[] = { a, b, c, d, e, f, rotation, sizeFactor };
+    std::string s;
+    for (const double val : v) {
+        char buf[32];
+        const auto res = std::to_chars(buf, buf + sizeof(buf), val);  // shortest exact form
+        s.append(buf, (size_t)(res.ptr - buf));
+        s += ';';
+    }
+    return s;
+}
+// ---
+void AffineTransform::ApplyToPoints(CoordBuffer& buf) const
+{
+    const double m[6] = { a, b, c, d, e, f };
+    TransformPoints(m, buf.x.data(), buf.y.data(), buf.Size());
+}
+// ---
+// "x", "y" is the upper left corner of the box with "w" and "h"
+void AffineTransform::ApplyToBox(double& x, double& y, double& w, double& h) const
+{
+    double nx, ny, nw, nh;
+    if (IsDiagonal()) {
+        nx = (a >= 0.0) ? (a * x) : (a * (x + w));
+        ny = (d >= 0.0) ? (d * y) : (d * (y + h));
+        nw = std::abs(a) * w;
+        nh = std::abs(d) * h;
+    } else if (IsAxisAligned()) {
+        // x and y are exchanged
+        nx = (b >= 0.0) ? (b * y) : (b * (y + h));
+        ny = (c >= 0.0) ? (c * x) : (c * (x + w));
+        nw = std::abs(b) * h;
+        nh = std::abs(c) * w;
+    } else {
+        // any other angle: the box stays parallel to the axes and
+        // is rotated around its center
+        nw = w * std::hypot(a, c);
+        nh = h * std::hypot(b, d);
+        double cx = x + w / 2.0;
+        double cy = y + h / 2.0;
+        Apply(cx, cy);
+        x = cx - nw / 2.0;
+        y = cy - nh / 2.0;
+        w = nw;
+        h = nh;
+        return;
+    }
+    x = (e == 0.0) ? nx : (nx + e);
+    y = (f == 0.0) ? ny : (ny + f);
+    w = nw;
+    h = nh;
+}
+// ---
+void AffineTransform::ApplyToRadii(double& rx, double& ry) const
+{
+    if (IsDiagonal()) {
+        rx *= std::abs(a);
+        ry *= std::abs(d);
+    } else if (IsAxisAligned()) {
+        const double tmp = rx;
+        rx = std::abs(b) * ry;
+        ry = std::abs(c) * tmp;
+    } else {
+        rx *= std::hypot(a, c);
+        ry *= std::hypot(b, d);
+    }
+}
+// ---
+// QET-angles: counter-clockwise, "0" is on the right side - the direction of
+// an angle is (cos(t), -sin(t)) because the y-axis points downwards
+void AffineTransform::ApplyToArc(double& start, double& angle) const
+{
+    const bool xReflect = ((a * d - b * c) < 0.0);
+    if (IsDiagonal()) {
+        // only the signs count: scaling keeps the angles of the ellipse
+        if      ((a > 0.0) && (d < 0.0)) { start = -start; }
+        else if ((a < 0.0) && (d > 0.0)) { start = 180.0 - start; }
+        else if ((a < 0.0) && (d < 0.0)) { start = 180.0 + start; }
+    } else if (IsAxisAligned()) {
+        if      ((b < 0.0) && (c > 0.0)) { start = start + 270.0; }
+        else if ((b > 0.0) && (c < 0.0)) { start = start + 90.0; }
+        else if ((b > 0.0) && (c > 0.0)) { start = 270.0 - start; }
+        else                             { start = 90.0 - start; }
+    } else {
+        // direction of the start-point through the matrix without scaling:
+        const double sx = std::hypot(a, c);
+        const double sy = std::hypot(b, d);
+        const double vx =  std::cos(toRad<double>(start));
+        const double vy = -std::sin(toRad<double>(start));
+        const double nx = (a / sx) * vx + (b / sy) * vy;
+        const double ny = (c / sx) * vx + (d / sy) * vy;
+        start = toDeg<double>(std::atan2(-ny, nx));
+    }
+    if (xReflect)
+        angle = -angle;
+}
+// ---
+char AffineTransform::ApplyToOrientation(const char o) const
+{
+    double dx, dy;
+    switch (o) {
+        case 'n': dx =  0.0; dy = -1.0; break;
+        case 'e': dx =  1.0; dy =  0.0; break;
+        case 's': dx =  0.0; dy =  1.0; break;
+        case 'w': dx = -1.0; dy =  0.0; break;
+        default:  return o;
+    }
+    // only the direction: without "e" and "f"
+    const double nx = a * dx + b * dy;
+    const double ny = c * dx + d * dy;
+    if (std::abs(nx) >= std::abs(ny))
+        return (nx >= 0.0) ? 'e' : 'w';
+    return (ny >= 0.0) ? 's' : 'n';
+}
+//
+//--- END - implementation of class "AffineTransform" --------------------------
+//
 
 
 /******************************************************************************/
 /******************************************************************************/
 /******************************************************************************/
 // Farbnamen von QET in RGB-Werte umwandeln
-std::string ColorToValue (const std::string & Color){
-  // hier die Liste der bekannten Farben:
-  std::map<std::string, std::string> ColorMap = {
-    {"white", "#FFFFFF"},
-    {"black", "#000000"},
-    {"green", "#00FF00"},
-    {"red", "#FF0000"},
-    {"blue", "#0000FF"},
-    {"gray", "#A0A0A4"},
-    {"grey", "#A0A0A4"},
-    {"brun", "#612C00"},
-    {"brown", "#612C00"},
-    {"yellow", "#FFFF00"},
-    {"cyan", "#00FFFF"},
-    {"magenta", "#FF00FF"},
-    {"lightgray", "#C0C0C0"},
-    {"orange", "#FF8000"},
-    {"purple", "#A020F0"},
-    {"HTMLPinkPink", "#FFC0CB"},
-    {"HTMLPinkLightPink", "#FFB6C1"},
-    {"HTMLPinkHotPink", "#FF69B4"},
-    {"HTMLPinkDeepPink", "#FF1493"},
-    {"HTMLPinkPaleVioletRed", "#DB7093"},
-    {"HTMLPinkMediumVioletRed", "#C71585"},
-    {"HTMLRedLightSalmon", "#FFA07A"},
-    {"HTMLRedSalmon", "#FA8072"},
-    {"HTMLRedDarkSalmon", "#E9967A"},
-    {"HTMLRedLightCoral", "#F08080"},
-    {"HTMLRedIndianRed", "#CD5C5C"},
-    {"HTMLRedCrimson", "#DC143C"},
-    {"HTMLRedFirebrick", "#B22222"},
-    {"HTMLRedDarkRed", "#8B0000"},
-    {"HTMLRedRed", "#FF0000"},
-    {"HTMLOrangeOrangeRed", "#FF4500"},
-    {"HTMLOrangeTomato", "#FF6347"},
-    {"HTMLOrangeCoral", "#FF7F50"},
-    {"HTMLOrangeDarkOrange", "#FF8C00"},
-    {"HTMLOrangeOrange", "#FFA500"},
-    {"HTMLYellowYellow", "#FFFF00"},
-    {"HTMLYellowLightYellow", "#FFFFE0"},
-    {"HTMLYellowLemonChiffon", "#FFFACD"},
+// die Liste der bekannten Farben - SORTIERT (Byte-Reihenfolge: erst
+// Groß-, dann Kleinbuchstaben) für die binäre Suche:
+struct ColorEntry {
+    std::string_view name;
+    const char*      value;
+};
+static constexpr ColorEntry ColorTable[] = {
+    {"HTMLBlueBlue",                   "#0000FF"},
+    {"HTMLBlueCornflowerBlue",         "#6495ED"},
+    {"HTMLBlueDarkBlue",               "#00008B"},
+    {"HTMLBlueDeepSkyBlue",            "#00BFFF"},
+    {"HTMLBlueDodgerBlue",             "#1E90FF"},
+    {"HTMLBlueLightBlue",              "#ADD8E6"},
+    {"HTMLBlueLightSkyBlue",           "#87CEFA"},
+    {"HTMLBlueLightSteelBlue",         "#B0C4DE"},
+    {"HTMLBlueMediumBlue",             "#0000CD"},
+    {"HTMLBlueMidnightBlue",           "#191970"},
+    {"HTMLBlueNavy",                   "#000080"},
+    {"HTMLBluePowderBlue",             "#B0E0E6"},
+    {"HTMLBlueRoyalBlue",              "#4169E1"},
+    {"HTMLBlueSkyBlue",                "#87CEEB"},
+    {"HTMLBlueSteelBlue",              "#4682B4"},
+    {"HTMLBrownBisque",                "#FFE4C4"},
+    {"HTMLBrownBlanchedAlmond",        "#FFEBCD"},
+    {"HTMLBrownBrown",                 "#A52A2A"},
+    {"HTMLBrownBurlywood",             "#DEB887"},
+    {"HTMLBrownChocolate",             "#D2691E"},
+    {"HTMLBrownCornsilk",              "#FFF8DC"},
+    {"HTMLBrownDarkGoldenrod",         "#B8860B"},
+    {"HTMLBrownGoldenrod",             "#DAA520"},
+    {"HTMLBrownMaroon",                "#B03060"},
+    {"HTMLBrownNavajoWhite",           "#FFDEAD"},
+    {"HTMLBrownPeru",                  "#CD853F"},
+    {"HTMLBrownRosyBrown",             "#BC8F8F"},
+    {"HTMLBrownSaddleBrown",           "#8B4513"},
+    {"HTMLBrownSandyBrown",            "#F4A460"},
+    {"HTMLBrownSienna",                "#A0522D"},
+    {"HTMLBrownTan",                   "#D2B48C"},
+    {"HTMLBrownWheat",                 "#F5DEB3"},
+    {"HTMLCyanAqua",                   "#00FFFF"},
+    {"HTMLCyanAquamarine",             "#7FFFD4"},
+    {"HTMLCyanCadetBlue",              "#5F9EA0"},
+    {"HTMLCyanCyan",                   "#00FFFF"},
+    {"HTMLCyanDarkCyan",               "#008B8B"},
+    {"HTMLCyanDarkTurquoise",          "#00CED1"},
+    {"HTMLCyanLightCyan",              "#E0FFFF"},
+    {"HTMLCyanLightSeaGreen",          "#20B2AA"},
+    {"HTMLCyanMediumTurquoise",        "#48D1CC"},
+    {"HTMLCyanPaleTurquoise",          "#AFEEEE"},
+    {"HTMLCyanTeal",                   "#008080"},
+    {"HTMLCyanTurquoise",              "#40E0D0"},
+    {"HTMLGrayBlack",                  "#000000"},
+    {"HTMLGrayDarkGray",               "#A9A9A9"},
+    {"HTMLGrayDarkSlateGray",          "#2F4F4F"},
+    {"HTMLGrayDimGray",                "#696969"},
+    {"HTMLGrayGainsboro",              "#DCDCDC"},
+    {"HTMLGrayGray",                   "#808080"},
+    {"HTMLGrayLightGray",              "#D3D3D3"},
+    {"HTMLGrayLightSlateGray",         "#778899"},
+    {"HTMLGraySilver",                 "#C0C0C0"},
+    {"HTMLGraySlateGray",              "#708090"},
+    {"HTMLGreenChartreuse",            "#7FFF00"},
+    {"HTMLGreenDarkGreen",             "#006400"},
+    {"HTMLGreenDarkOliveGreen",        "#556B2F"},
+    {"HTMLGreenDarkSeaGreen",          "#8FBC8F"},
+    {"HTMLGreenForestGreen",           "#228B22"},
+    {"HTMLGreenGreen",                 "#008000"},
+    {"HTMLGreenGreenYellow",           "#ADFF2F"},
+    {"HTMLGreenLawnGreen",             "#7CFC00"},
+    {"HTMLGreenLightGreen",            "#90EE90"},
+    {"HTMLGreenLime",                  "#C0FF00"},
+    {"HTMLGreenLimeGreen",             "#32CD32"},
+    {"HTMLGreenMediumAquamarine",      "#66CDAA"},
+    {"HTMLGreenMediumSeaGreen",        "#3CB371"},
+    {"HTMLGreenMediumSpringGreen",     "#00FA9A"},
+    {"HTMLGreenOlive",                 "#808000"},
+    {"HTMLGreenOliveDrab",             "#6B8E23"},
+    {"HTMLGreenPaleGreen",             "#98FB98"},
+    {"HTMLGreenSeaGreen",              "#2E8B57"},
+    {"HTMLGreenSpringGreen",           "#00FF7F"},
+    {"HTMLGreenYellowGreen",           "#9ACD32"},
+    {"HTMLOrangeCoral",                "#FF7F50"},
+    {"HTMLOrangeDarkOrange",           "#FF8C00"},
+    {"HTMLOrangeOrange",               "#FFA500"},
+    {"HTMLOrangeOrangeRed",            "#FF4500"},
+    {"HTMLOrangeTomato",               "#FF6347"},
+    {"HTMLPinkDeepPink",               "#FF1493"},
+    {"HTMLPinkHotPink",                "#FF69B4"},
+    {"HTMLPinkLightPink",              "#FFB6C1"},
+    {"HTMLPinkMediumVioletRed",        "#C71585"},
+    {"HTMLPinkPaleVioletRed",          "#DB7093"},
+    {"HTMLPinkPink",                   "#FFC0CB"},
+    {"HTMLPurpleBlueViolet",           "#8A2BE2"},
+    {"HTMLPurpleDarkMagenta",          "#8B008B"},
+    {"HTMLPurpleDarkOrchid",           "#9932CC"},
+    {"HTMLPurpleDarkSlateBlue",        "#483D8B"},
+    {"HTMLPurpleDarkViolet",           "#9400D3"},
+    {"HTMLPurpleFuchsia",              "#FF00FF"},
+    {"HTMLPurpleIndigo",               "#4B0082"},
+    {"HTMLPurpleLavender",             "#E6E6FA"},
+    {"HTMLPurpleMagenta",              "#FF00FF"},
+    {"HTMLPurpleMediumOrchid",         "#BA55D3"},
+    {"HTMLPurpleMediumPurple",         "#9370DB"},
+    {"HTMLPurpleMediumSlateBlue",      "#7B68EE"},
+    {"HTMLPurpleOrchid",               "#DA70D6"},
+    {"HTMLPurplePlum",                 "#DDA0DD"},
+    {"HTMLPurplePurple",               "#800080"},
+    {"HTMLPurpleSlateBlue",            "#6A5ACD"},
+    {"HTMLPurpleThistle",              "#D8BFD8"},
+    {"HTMLPurpleViolet",               "#EE82EE"},
+    {"HTMLRedCrimson",                 "#DC143C"},
+    {"HTMLRedDarkRed",                 "#8B0000"},
+    {"HTMLRedDarkSalmon",              "#E9967A"},
+    {"HTMLRedFirebrick",               "#B22222"},
+    {"HTMLRedIndianRed",               "#CD5C5C"},
+    {"HTMLRedLightCoral",              "#F08080"},
+    {"HTMLRedLightSalmon",             "#FFA07A"},
+    {"HTMLRedRed",                     "#FF0000"},
+    {"HTMLRedSalmon",                  "#FA8072"},
+    {"HTMLWhiteAliceBlue",             "#F0F8FF"},
+    {"HTMLWhiteAntiqueWhite",          "#FAEBD7"},
+    {"HTMLWhiteAzure",                 "#F0FFFF"},
+    {"HTMLWhiteBeige",                 "#F5F5DC"},
+    {"HTMLWhiteFloralWhite",           "#FFFAF0"},
+    {"HTMLWhiteGhostWhite",            "#F8F8FF"},
+    {"HTMLWhiteHoneydew",              "#F0FFF0"},
+    {"HTMLWhiteIvory",                 "#FFFFF0"},
+    {"HTMLWhiteLavenderBlush",         "#FFF0F5"},
+    {"HTMLWhiteLinen",                 "#FAF0E6"},
+    {"HTMLWhiteMintCream",             "#F5FFFA"},
+    {"HTMLWhiteMistyRose",             "#FFE4E1"},
+    {"HTMLWhiteOldLace",               "#FDF5E6"},
+    {"HTMLWhiteSeashell",              "#FFF5EE"},
+    {"HTMLWhiteSnow",                  "#FFFAFA"},
+    {"HTMLWhiteWhite",                 "#FFFFFF"},
+    {"HTMLWhiteWhiteSmoke",            "#F5F5F5"},
+    {"HTMLYellowDarkKhaki",            "#BDB76B"},
+    {"HTMLYellowGold",                 "#FFD700"},
+    {"HTMLYellowKhaki",                "#F0E68C"},
+    {"HTMLYellowLemonChiffon",         "#FFFACD"},
     {"HTMLYellowLightGoldenrodYellow", "#FAFAD2"},
-    {"HTMLYellowPapayaWhip", "#FFEFD5"},
-    {"HTMLYellowMoccasin", "#FFE4B5"},
-    {"HTMLYellowPeachPuff", "#FFDAB9"},
-    {"HTMLYellowPaleGoldenrod", "#EEE8AA"},
-    {"HTMLYellowKhaki", "#F0E68C"},
-    {"HTMLYellowDarkKhaki", "#BDB76B"},
-    {"HTMLYellowGold", "#FFD700"},
-    {"HTMLBrownCornsilk", "#FFF8DC"},
-    {"HTMLBrownBlanchedAlmond", "#FFEBCD"},
-    {"HTMLBrownBisque", "#FFE4C4"},
-    {"HTMLBrownNavajoWhite", "#FFDEAD"},
-    {"HTMLBrownWheat", "#F5DEB3"},
-    {"HTMLBrownBurlywood", "#DEB887"},
-    {"HTMLBrownTan", "#D2B48C"},
-    {"HTMLBrownRosyBrown", "#BC8F8F"},
-    {"HTMLBrownSandyBrown", "#F4A460"},
-    {"HTMLBrownGoldenrod", "#DAA520"},
-    {"HTMLBrownDarkGoldenrod", "#B8860B"},
-    {"HTMLBrownPeru", "#CD853F"},
-    {"HTMLBrownChocolate", "#D2691E"},
-    {"HTMLBrownSaddleBrown", "#8B4513"},
-    {"HTMLBrownSienna", "#A0522D"},
-    {"HTMLBrownBrown", "#A52A2A"},
-    {"HTMLBrownMaroon", "#B03060"},
-    {"HTMLGreenDarkOliveGreen", "#556B2F"},
-    {"HTMLGreenOlive", "#808000"},
-    {"HTMLGreenOliveDrab", "#6B8E23"},
-    {"HTMLGreenYellowGreen", "#9ACD32"},
-    {"HTMLGreenLimeGreen", "#32CD32"},
-    {"HTMLGreenLime", "#C0FF00"},
-    {"HTMLGreenLawnGreen", "#7CFC00"},
-    {"HTMLGreenChartreuse", "#7FFF00"},
-    {"HTMLGreenGreenYellow", "#ADFF2F"},
-    {"HTMLGreenSpringGreen", "#00FF7F"},
-    {"HTMLGreenMediumSpringGreen", "#00FA9A"},
-    {"HTMLGreenLightGreen", "#90EE90"},
-    {"HTMLGreenPaleGreen", "#98FB98"},
-    {"HTMLGreenDarkSeaGreen", "#8FBC8F"},
-    {"HTMLGreenMediumAquamarine", "#66CDAA"},
-    {"HTMLGreenMediumSeaGreen", "#3CB371"},
-    {"HTMLGreenSeaGreen", "#2E8B57"},
-    {"HTMLGreenForestGreen", "#228B22"},
-    {"HTMLGreenGreen", "#008000"},
-    {"HTMLGreenDarkGreen", "#006400"},
-    {"HTMLCyanAqua", "#00FFFF"},
-    {"HTMLCyanCyan", "#00FFFF"},
-    {"HTMLCyanLightCyan", "#E0FFFF"},
-    {"HTMLCyanPaleTurquoise", "#AFEEEE"},
-    {"HTMLCyanAquamarine", "#7FFFD4"},
-    {"HTMLCyanTurquoise", "#40E0D0"},
-    {"HTMLCyanMediumTurquoise", "#48D1CC"},
-    {"HTMLCyanDarkTurquoise", "#00CED1"},
-    {"HTMLCyanLightSeaGreen", "#20B2AA"},
-    {"HTMLCyanCadetBlue", "#5F9EA0"},
-    {"HTMLCyanDarkCyan", "#008B8B"},
-    {"HTMLCyanTeal", "#008080"},
-    {"HTMLBlueLightSteelBlue", "#B0C4DE"},
-    {"HTMLBluePowderBlue", "#B0E0E6"},
-    {"HTMLBlueLightBlue", "#ADD8E6"},
-    {"HTMLBlueSkyBlue", "#87CEEB"},
-    {"HTMLBlueLightSkyBlue", "#87CEFA"},
-    {"HTMLBlueDeepSkyBlue", "#00BFFF"},
-    {"HTMLBlueDodgerBlue", "#1E90FF"},
-    {"HTMLBlueCornflowerBlue", "#6495ED"},
-    {"HTMLBlueSteelBlue", "#4682B4"},
-    {"HTMLBlueRoyalBlue", "#4169E1"},
-    {"HTMLBlueBlue", "#0000FF"},
-    {"HTMLBlueMediumBlue", "#0000CD"},
-    {"HTMLBlueDarkBlue", "#00008B"},
-    {"HTMLBlueNavy", "#000080"},
-    {"HTMLBlueMidnightBlue", "#191970"},
-    {"HTMLPurpleLavender", "#E6E6FA"},
-    {"HTMLPurpleThistle", "#D8BFD8"},
-    {"HTMLPurplePlum", "#DDA0DD"},
-    {"HTMLPurpleViolet", "#EE82EE"},
-    {"HTMLPurpleOrchid", "#DA70D6"},
-    {"HTMLPurpleFuchsia", "#FF00FF"},
-    {"HTMLPurpleMagenta", "#FF00FF"},
-    {"HTMLPurpleMediumOrchid", "#BA55D3"},
-    {"HTMLPurpleMediumPurple", "#9370DB"},
-    {"HTMLPurpleBlueViolet", "#8A2BE2"},
-    {"HTMLPurpleDarkViolet", "#9400D3"},
-    {"HTMLPurpleDarkOrchid", "#9932CC"},
-    {"HTMLPurpleDarkMagenta", "#8B008B"},
-    {"HTMLPurplePurple", "#800080"},
-    {"HTMLPurpleIndigo", "#4B0082"},
-    {"HTMLPurpleDarkSlateBlue", "#483D8B"},
-    {"HTMLPurpleSlateBlue", "#6A5ACD"},
-    {"HTMLPurpleMediumSlateBlue", "#7B68EE"},
-    {"HTMLWhiteWhite", "#FFFFFF"},
-    {"HTMLWhiteSnow", "#FFFAFA"},
-    {"HTMLWhiteHoneydew", "#F0FFF0"},
-    {"HTMLWhiteMintCream", "#F5FFFA"},
-    {"HTMLWhiteAzure", "#F0FFFF"},
-    {"HTMLWhiteAliceBlue", "#F0F8FF"},
-    {"HTMLWhiteGhostWhite", "#F8F8FF"},
-    {"HTMLWhiteWhiteSmoke", "#F5F5F5"},
-    {"HTMLWhiteSeashell", "#FFF5EE"},
-    {"HTMLWhiteBeige", "#F5F5DC"},
-    {"HTMLWhiteOldLace", "#FDF5E6"},
-    {"HTMLWhiteFloralWhite", "#FFFAF0"},
-    {"HTMLWhiteIvory", "#FFFFF0"},
-    {"HTMLWhiteAntiqueWhite", "#FAEBD7"},
-    {"HTMLWhiteLinen", "#FAF0E6"},
-    {"HTMLWhiteLavenderBlush", "#FFF0F5"},
-    {"HTMLWhiteMistyRose", "#FFE4E1"},
-    {"HTMLGrayGainsboro", "#DCDCDC"},
-    {"HTMLGrayLightGray", "#D3D3D3"},
-    {"HTMLGraySilver", "#C0C0C0"},
-    {"HTMLGrayDarkGray", "#A9A9A9"},
-    {"HTMLGrayGray", "#808080"},
-    {"HTMLGrayDimGray", "#696969"},
-    {"HTMLGrayLightSlateGray", "#778899"},
-    {"HTMLGraySlateGray", "#708090"},
-    {"HTMLGrayDarkSlateGray", "#2F4F4F"},
-    {"HTMLGrayBlack", "#000000"},
-    {"none", "none"}
-  };
+    {"HTMLYellowLightYellow",          "#FFFFE0"},
+    {"HTMLYellowMoccasin",             "#FFE4B5"},
+    {"HTMLYellowPaleGoldenrod",        "#EEE8AA"},
+    {"HTMLYellowPapayaWhip",           "#FFEFD5"},
+    {"HTMLYellowPeachPuff",            "#FFDAB9"},
+    {"HTMLYellowYellow",               "#FFFF00"},
+    {"black",                          "#000000"},
+    {"blue",                           "#0000FF"},
+    {"brown",                          "#612C00"},
+    {"brun",                           "#612C00"},
+    {"cyan",                           "#00FFFF"},
+    {"gray",                           "#A0A0A4"},
+    {"green",                          "#00FF00"},
+    {"grey",                           "#A0A0A4"},
+    {"lightgray",                      "#C0C0C0"},
+    {"magenta",                        "#FF00FF"},
+    {"none",                           "none"},
+    {"orange",                         "#FF8000"},
+    {"purple",                         "#A020F0"},
+    {"red",                            "#FF0000"},
+    {"white",                          "#FFFFFF"},
+    {"yellow",                         "#FFFF00"},
+};
+// ---
+static constexpr bool IsSorted(const ColorEntry* p, const size_t n) {
+    for (size_t i = 1; i < n; i++)
+        if (!(p[i-1].name < p[i].name)) return false;
+    return true;
+}
+static_assert(IsSorted(ColorTable, std::size(ColorTable)), "ColorTable must be sorted!");
+// ---
+const char* ColorToValue (std::string_view Color){
   // Suche und Ausgabe der Farbe:
-  std::string Value = ColorMap[Color];
-  if ((Value == "none") || (Value.length() == 7))
-    return Value;
+  const auto it = std::lower_bound(std::begin(ColorTable), std::end(ColorTable), Color,
+                      [](const ColorEntry& e, std::string_view v) { return e.name < v; });
+  if ((it != std::end(ColorTable)) && (it->name == Color))
+    return it->value;
   else
     return "#696969";
 }
@@ -1765,26 +2431,36 @@ std::string ColorToValue (const std::string & Color){
 /******************************************************************************/
 /******************************************************************************/
 /******************************************************************************/
-std::string FontToFontFamily (const std::string & s){
-    std::string sFontFamily;
-    if      ( (!(s.find("Sans") == std::string::npos)) ||
-              (!(s.find("Arial") == std::string::npos)) ||
-              (!(s.find("MS Shell Dlg") == std::string::npos)) )  {
-        sFontFamily = "Sans Serif,MS Sans Serif"; // "Arial", "Tahoma", "MS Sans Serif"
-        }
-    else if ( (!(s.find("Mono") == std::string::npos)) ||
-              (!(s.find("Fixed") == std::string::npos)) ||
-              (!(s.find("Courier") == std::string::npos)))  {
-        sFontFamily = "Monospace,Courier New"; // "Courier", "Courier New", "Fixedsys", "Console", "Terminal"
-        }
-    else if ( (!(s.find("Serif") == std::string::npos)) ||
-              (!(s.find("Times") == std::string::npos)))  {
-        sFontFamily = "Serif,MS Serif"; // "Times", "Times New Roman", "MS Serif"
-        }
-    else {
-        sFontFamily = "Sans Serif,MS Sans Serif"; // "Arial", "Tahoma", "MS Sans Serif"
-        }
-    return sFontFamily;
+// die Schriftart wird einer generischen Schriftfamilie zugeordnet;
+// die Reihenfolge der Tabelle ist die Priorität ("Sans Serif" ist "Sans"!)
+struct FontEntry {
+    std::string_view part;
+    FontFamily       family;
+};
+static constexpr FontEntry FontTable[] = {
+    {"Sans",         FontFamily::sans},
+    {"Arial",        FontFamily::sans},
+    {"MS Shell Dlg", FontFamily::sans},
+    {"Mono",         FontFamily::mono},
+    {"Fixed",        FontFamily::mono},
+    {"Courier",      FontFamily::mono},
+    {"Serif",        FontFamily::serif},
+    {"Times",        FontFamily::serif},
+};
+// ---
+FontFamily ClassifyFont (std::string_view s){
+    for (const auto& e : FontTable)
+        if (s.find(e.part) != std::string_view::npos)
+            return e.family;
+    return FontFamily::sans;
+}
+// ---
+const char* FontToFontFamily (std::string_view s){
+    switch (ClassifyFont(s)) {
+        case FontFamily::mono:  return "Monospace,Courier New";    // "Courier", "Courier New", "Fixedsys", "Console", "Terminal"
+        case FontFamily::serif: return "Serif,MS Serif";           // "Times", "Times New Roman", "MS Serif"
+        default:                return "Sans Serif,MS Sans Serif"; // "Arial", "Tahoma", "MS Sans Serif"
+    }
 }
 /******************************************************************************/
 /******************************************************************************/
@@ -35,23 +35,115 @@
 #include <cmath>        // sqrt, ...
 #include <vector>       // für Polygone
 #include <map>          // die Namen des Elements
+#include <string_view>  // Farb- und Schrift-Tabellen
 
 #include "pugixml/pugixml.hpp"
+#include "coords.h"
 
 
 //
 // --- function-prototypes for ... ---------------------------------------------
 //
-std::string ColorToValue (const std::string&);
+const char* ColorToValue (std::string_view);  // "none", "#RRGGBB"
 
-std::string FontToFontFamily (const std::string&);
+enum class FontFamily : uint8_t { sans, mono, serif };
+FontFamily ClassifyFont (std::string_view);
+const char* FontToFontFamily (std::string_view);
 
 bool MultiLineText(std::string, std::vector<std::string> & );
 
 class RectMinMax;
+class SvgWriter;   // see "fileio.h"
+
+
+
+//
+//--- definition of class "AffineTransform" ------------------------------------
+//
+// all geometric operations of the command-line composed into ONE matrix:
+//   x' = a * x + b * y + e
+//   y' = c * x + d * y + f
+// the y-axis points downwards (like in QET): positive angles rotate
+// clockwise on the screen (like "--Rot90")
+//
+class AffineTransform {
+   private:
+      double a = 1.0, b = 0.0, c = 0.0, d = 1.0, e = 0.0, f = 0.0;
+      double rotation   = 0.0;  // sum of all rotations: for texts
+      double sizeFactor = 1.0;  // product of "min(sx, sy)" of all scalings: for texts
+      void Append(const double, const double, const double, const double,
+                  const double, const double);
+      bool IsDiagonal(void) const { return (b == 0.0) && (c == 0.0); }
+      //
+   public:
+      void FlipX(void)  { Append(-1.0, 0.0, 0.0,  1.0, 0.0, 0.0); }  // x = -x  ("Mirror")
+      void FlipY(void)  { Append( 1.0, 0.0, 0.0, -1.0, 0.0, 0.0); }  // y = -y  ("Flip")
+      void Rotate(const double deg);                                  // clockwise
+      void Scale(const double sx, const double sy);
+      void Move(const double dx, const double dy) { Append(1.0, 0.0, 0.0, 1.0, dx, dy); }
+      // x- and y-axis stay parallel to the axes (flip, 90°-steps, scale, move)?
+      bool IsAxisAligned(void) const { return IsDiagonal() || ((a == 0.0) && (d == 0.0)); }
+      double GetRotation(void)   const { return rotation; }
+      double GetSizeFactor(void) const { return sizeFactor; }
+      void Apply(double& x, double& y) const;                  // a point
+      void ApplyToPoints(CoordBuffer&) const;                  // all points at once ("--simd")
+      void ApplyToBox(double& x, double& y, double& w, double& h) const;
+      void ApplyToRadii(double& rx, double& ry) const;         // of a rounded rect
+      void ApplyToArc(double& start, double& angle) const;     // QET-angles in degree
+      char ApplyToOrientation(const char o) const;            // 'n', 'e', 's', 'w'
+      std::string AsKey(void) const;                           // all values exactly
+};
+//
+//--- END - definition of class "AffineTransform" ------------------------------
+//
+
+
+//
+// --- the names of all attributes we read from the primitives -----------------
+//
+// every "ReadFromPugiNode" walks once through the attributes of its node
+// and dispatches on the "Attr" of the name instead of searching each
+// attribute by name with "node.attribute(...)"
+//
+enum class Attr : uint8_t {
+    x, y, z, width, height, diameter, rx, ry,
+    x1, y1, x2, y2, length1, length2, end1, end2,
+    start, angle, closed, antialias, style,
+    rotate, rotation, Halignment, Valignment, font_size, size, text_width,
+    text, text_from, font, color, frame, uuid, keep_visual_rotation, tagg,
+    orientation, type, name, version, link_type, hotspot_x, hotspot_y,
+    unknown,
+    points  // no attribute: the block of "x<n>"/"y<n>" of a polygon in an order-table
+};
+Attr LookupAttr(const char*);
+// calls "f(Attr, xml_attribute)" for every known attribute of "node" - like
+// "node.attribute(name)" only the first attribute with the same name counts
+template <typename F>
+void ForEachAttr(const pugi::xml_node& node, F f) {
+    uint64_t seen = 0;
+    for (pugi::xml_attribute attr : node.attributes()) {
+        Attr id = LookupAttr(attr.name());
+        if (id == Attr::unknown)
+            continue;
+        uint64_t bit = (uint64_t)1 << (uint8_t)id;
+        if ((seen & bit) != 0)
+            continue;
+        seen |= bit;
+        f(id, attr);
+    }
+}
+
+//
+// --- the kinds of nodes in "description" -------------------------------------
+//
+// classified once per node: the loops over the primitives use a "switch"
+//
+enum class NodeKind : uint8_t {
+    rect, arc, ellipse, circle, text, terminal, input, dynamic_text, line, polygon,
+    other
+};
+NodeKind LookupNodeKind(const char*);
 
-void RotPos90(double&, double&, double&, double&);
-void RotPoint90(double&, double&);
 
 //
 // für die Verwaltung von grafischen Elementen:
@@ -69,6 +161,70 @@ struct PolyPoint
     PolyPoint(const uint64_t& n, const double& inx, const double& iny) : i(n), x(inx), y(iny) {}
 };
 
+//
+//--- definition of class "AttrWriter" -----------------------------------------
+//
+// rebuilds the attributes of a node in one pass: the "WriteToPugiNode"
+// functions collect the new values and "Commit" writes the attribute-list
+// in the order
+//   [front] - untouched attributes - attributes of the order-table
+// the result is the same as "remove_attribute" and "append_attribute"
+// (or "prepend_attribute" for "front") for every written attribute, but
+// the existing attributes are overwritten in place
+//
+class AttrWriter {
+   private:
+      struct Entry {
+          const char* name;   // static name or "nullptr": name in "buf"
+          size_t nameOff, nameLen;
+          size_t valOff, valLen;
+          ptrdiff_t slot;     // untouched attribute: old position, else "-1"
+      };
+      struct Value { uint8_t state = 0; size_t off = 0, len = 0; };
+      enum : uint8_t { StateUnset = 0, StateSet = 1, StateRemoved = 2 };
+      pugi::xml_node& node;
+      const Attr* order;
+      size_t      nOrder;
+      Attr        front;
+      uint64_t    present = 0;                     // bitmask of existing "Attr"
+      Value       values[(size_t)Attr::unknown];
+      const std::vector<PolyPoint>* points = nullptr;
+      size_t      pointDecimals = 0;
+      struct Scratch {
+          std::string buf;                         // new names and values
+          std::vector<Entry> entries;              // the new attribute-list
+          std::vector<uint8_t> pointFlags;         // per point-index: written/found
+      };
+      static Scratch& GetScratch(void);            // per thread: reused for every node
+      Scratch& scratch;
+      void Store(const Attr id, const size_t off);
+      bool IsWrittenPoint(const char* name);
+      //
+   public:
+      template <size_t N>
+      AttrWriter(pugi::xml_node& n, const Attr (&ord)[N], const Attr frontAttr = Attr::unknown)
+                 : AttrWriter(n, ord, N, frontAttr) {}
+      AttrWriter(pugi::xml_node&, const Attr*, const size_t, const Attr);
+      AttrWriter(const AttrWriter&) = delete;
+      AttrWriter& operator=(const AttrWriter&) = delete;
+      bool Has(const Attr id) const { return (present & ((uint64_t)1 << (uint8_t)id)) != 0; }
+      void Set(const Attr id, const char* value);
+      void Set(const Attr id, const std::string& value);
+      void Set(const Attr id, const double value, const size_t dec);
+      void Set(const Attr id, const bool value) { Set(id, (value ? "true" : "false")); }
+      void Set(const Attr id, const int value);
+      void SetIfPresent(const Attr id, const char* value) { if (Has(id)) Set(id, value); }
+      void SetIfPresent(const Attr id, const std::string& value) { if (Has(id)) Set(id, value); }
+      void SetIfPresent(const Attr id, const double value, const size_t dec) { if (Has(id)) Set(id, value, dec); }
+      void SetIfPresent(const Attr id, const bool value) { if (Has(id)) Set(id, value); }
+      void Remove(const Attr id) { values[(size_t)id].state = StateRemoved; }
+      void Points(const std::vector<PolyPoint>& pts, const size_t dec) { points = &pts; pointDecimals = dec; }
+      void Commit(void);
+};
+//
+//--- END - definition of class "AttrWriter" -----------------------------------
+//
+
 
 
 struct EInfo
@@ -172,6 +328,10 @@ class BaseElement {
 //--- END - definition of class "BaseElement" ----------------------------------
 //
 
+// "line-style:..." and "line-weight:..." of the style-attribute
+enum class LineStyle  : uint8_t { normal, dotted, dashed, dashdotted };
+enum class LineWeight : uint8_t { none, thin, normal, hight, eleve };
+
 //
 //--- definition of class "BaseStyle" ------------------------------------------
 //
@@ -180,10 +340,10 @@ class BaseStyle {
       // enthält Daten zu Linien-Stil, etc:
       bool        antialias = false;
       std::string style = "line-style:normal;line-weight:normal;filling:none;color:black";
-      std::string lineStyle = "normal"; // "normal", "dotted", "dashed", "dash-dotted"
-      std::string lineWeight = "normal"; // "none", "thin", "normal", "hight", "eleve"
-      std::string lineFilling = "none"; // Füllfarbe
-      std::string lineColor = "black"; // Zeichenfarbe
+      LineStyle   lineStyle   = LineStyle::normal;
+      LineWeight  lineWeight  = LineWeight::normal;
+      const char* lineFilling = "none";     // Füllfarbe (aus "ColorToValue")
+      const char* lineColor   = "#000000";  // Zeichenfarbe (aus "ColorToValue")
    public:
       BaseStyle() {
                    // std::cerr << " default-constructor BaseStyle\n";
@@ -191,22 +351,15 @@ class BaseStyle {
       bool        GetAntialias() { return antialias; }
       std::string GetStyle() { return style; }
       double GetLineWidth() {
-              if      (lineWeight == "none")
-                  return 0.0;
-              else if (lineWeight == "thin")
-                  return 0.25;
-              else if (lineWeight == "normal")
-                  return 1.0;
-              else if (lineWeight == "hight")
-                  return 2.0;
-              else if (lineWeight == "eleve")
-                  return 5.0;
-              else
-                  return 1.0;
+              // in the order of "LineWeight":
+              static constexpr double LineWidths[] = { 0.0, 0.25, 1.0, 2.0, 5.0 };
+              return LineWidths[static_cast<uint8_t>(lineWeight)];
       }
       void SetAntialias(const bool& val) { antialias = val; }
       void SetStyle(const std::string& val) { style = val; }
-      std::string StyleAsSVGstring(const size_t&);
+      void ParseStyle(void);                              // "style" --> lineStyle, ...
+      std::string BuildSVGstring(const size_t&);          // lineStyle, ... --> SVG
+      const std::string& StyleAsSVGstring(const size_t&); // both - with cache
 };
 //
 //--- END - definition of class "BaseStyle" ------------------------------------
@@ -240,7 +393,8 @@ class BasePosition {
       double GetY() { return y; }
       double GetZ() { return z; }
       void ReadPosition(pugi::xml_node&);
-      void WritePosition(pugi::xml_node&, const size_t&);
+      bool ReadPositionAttr(const Attr, const pugi::xml_attribute&);
+      void WritePosition(AttrWriter&, const size_t&);
       void SetX(const double& val) { x = val; }
       void SetY(const double& val) { y = val; }
       void SetZ(const double& val) { z = val; }
@@ -261,6 +415,7 @@ class BaseSize {
    protected:
       double width = 0.0;
       double height = 0.0;
+      bool xDiameter = false;  // while reading: "circle" instead of "ellipse"
    public:
       BaseSize() {
                   // std::cout << " default-constructor BaseSize\n";
@@ -273,7 +428,9 @@ class BaseSize {
       double GetWidth()                 { return width; }
       double GetHeight()                { return height; }
       void ReadSize(pugi::xml_node&);
-      void WriteSize(pugi::xml_node&, const size_t&);
+      bool ReadSizeAttr(const Attr, const pugi::xml_attribute&);
+      void ReadSizeDone(pugi::xml_node&);
+      void WriteSize(AttrWriter&, const size_t&);
       void SetWidth(const double& val)  { width = val; }
       void SetHeight(const double& val) { height = val; }
       void SwapWidhHeight(void)         { double tmp = width;
@@ -393,15 +550,8 @@ class ElmtDynText : public BaseElement,
       void CreateFontString(void);
       int GetSize(void) { return (int)round(size); }
       std::string GetText(void) { return text; }
-      void Flip(void)   { y = (-1) * y; }
-      void Mirror(void) { x = (-1) * x; }
-      void Rot90(void);  // rotate clockwise by 90°
-      void Scale(const double& factX=1.0, const double& factY=1.0) {
-                       x *= factX; y *= factY;
-                       size *= std::min(factX, factY);
-                       CreateFontString();
-                       }
-      std::string AsSVGstring(const size_t&);
+      void Transform(const AffineTransform&);
+      void WriteSVG(SvgWriter&, const size_t&);
 };
 //
 //--- END - definition of class "ElmtDynText" ----------------------------------
@@ -485,15 +635,8 @@ class ElmtText : public BaseElement,
       void CreateFontString(void);
       int GetSize(void) { return (int)round(size); }
       std::string GetText(void) { return text; }
-      void Flip(void)   { y = (-1) * y; }
-      void Mirror(void) { x = (-1) * x; }
-      void Rot90(void);  // rotate clockwise by 90°
-      void Scale(const double& factX=1.0, const double& factY=1.0) {
-                       x *= factX; y *= factY;
-                       size *= std::min(factX, factY);
-                       CreateFontString();
-                       }
-      std::string AsSVGstring(const size_t&);
+      void Transform(const AffineTransform&);
+      void WriteSVG(SvgWriter&, const size_t&);
 };
 //
 //--- END - definition of class "ElmtText" -------------------------------------
@@ -510,6 +653,11 @@ class ElmtPolygon : public BaseElement,
    protected:
       std::vector<PolyPoint> polygon;
       bool closed = true;
+      double MinX =  1e99;
+      double MaxX = -1e99;
+      double MinY =  1e99;
+      double MaxY = -1e99;
+      void DetermineMinMax();
    private:
       //
    public:
@@ -521,42 +669,22 @@ class ElmtPolygon : public BaseElement,
                        }
       bool ReadFromPugiNode(pugi::xml_node&);
       void WriteToPugiNode(pugi::xml_node&, const size_t&);
-      double GetMaxX() {
-          double MaxX = -1e99;
-          for (const auto &pt : polygon)
-              MaxX = std::max(MaxX, pt.x);
-          return MaxX;
-          }
-      double GetMinX() {
-          double MinX = 1e99;
-          for (const auto &pt : polygon)
-              MinX = std::min(MinX, pt.x);
-          return MinX;
-          }
-      double GetMaxY() {
-          double MaxY = -1e99;
-          for (const auto &pt : polygon)
-              MaxY = std::max(MaxY, pt.y);
-          return MaxY;
-          }
-      double GetMinY() {
-          double MinY = 1e99;
-          for (const auto &pt : polygon)
-              MinY = std::min(MinY, pt.y);
-          return MinY;
-          }
+      // bounding box: determined by "Transform" and "CleanUp"
+      double GetMaxX() { return MaxX; }
+      double GetMinX() { return MinX; }
+      double GetMaxY() { return MaxY; }
+      double GetMinY() { return MinY; }
       void Clear(){ polygon.clear(); closed = true; }
       bool CheckIndex(const std::string);
       virtual void Write(void) {
                          for(const auto &pt : polygon)
                              std::cout << pt.i << " - " << pt.x << " - " << pt.y << "\n";
                          }
-      std::string AsSVGstring(const size_t&);
-      void Flip(void);   // vertikal
-      void Mirror(void); // horizontal
-      void Rot90(void);  // rotate clockwise by 90°
-      void Move(const double& dx, const double& dy);  // move by dx, dy
-      void Scale(const double& factX=1.0, const double& factY=1.0);
+      void WriteSVG(SvgWriter&, const size_t&);
+      void Transform(const AffineTransform&);  // all points in one pass
+      // "--simd": the points are transformed in a shared buffer
+      size_t GatherPoints(CoordBuffer&) const;             // returns the offset
+      void ScatterPoints(const CoordBuffer&, const size_t);
       void CleanUp(pugi::xml_node&, const double&);
 };
 //
@@ -597,15 +725,15 @@ class ElmtLine : public ElmtPolygon {
                            std::cout << length1 << " | " << length2 << "\n" << end1 << " | " << end2 << "\n";
                          }
                        }
-      //void Flip(void);   // hier nix definiert: wird von übergeordneter Klasse "Polygon" übernommen!
-      //void Mirror(void); // hier nix definiert: wird von übergeordneter Klasse "Polygon" übernommen!
-      //void Rot90(void);  // hier nix definiert: wird von übergeordneter Klasse "Polygon" übernommen!
-      void Scale(const double& factX=1.0, const double& factY=1.0) {
-                         ElmtPolygon::Scale(factX, factY);
-                         length1 *= std::min(factX, factY); length1 = std::min(length1, 99.0);
-                         length2 *= std::min(factX, factY); length2 = std::min(length2, 99.0);
+      void Transform(const AffineTransform& t) {
+                         ElmtPolygon::Transform(t);
+                         TransformLengths(t);
+                       }
+      void TransformLengths(const AffineTransform& t) {
+                         length1 *= t.GetSizeFactor(); length1 = std::min(length1, 99.0);
+                         length2 *= t.GetSizeFactor(); length2 = std::min(length2, 99.0);
                        }
-      std::string AsSVGstring(const size_t&);
+      void WriteSVG(SvgWriter&, const size_t&);
 };
 //
 //--- END - definition of class "ElmtLine" -------------------------------------
@@ -632,14 +760,8 @@ class ElmtEllipse : public BaseElement,
       void Clear(void) { BasePosition::Clear(); BaseSize::Clear(); }
       void ReadFromPugiNode(pugi::xml_node&);
       void WriteToPugiNode(pugi::xml_node&, const size_t&);
-      void Flip(void)   { y = (-1) * y - height; }
-      void Mirror(void) { x = (-1) * x - width; }
-      void Rot90();  // rotate clockwise by 90°
-      void Scale(const double& factX=1.0, const double& factY=1.0) {
-                       x     *= factX;      y *= factY;
-                       width *= factX; height *= factY;
-                       }
-      std::string AsSVGstring(const size_t&);
+      void Transform(const AffineTransform& t) { t.ApplyToBox(x, y, width, height); }
+      void WriteSVG(SvgWriter&, const size_t&);
 };
 //
 //--- END - definition of class "ElmtEllipse" ----------------------------------
@@ -671,15 +793,11 @@ class ElmtRect : public BaseElement,
         double GetRy(void)      { return ry; }
         void SetRx(const double& val)      { rx = val; }
         void SetRy(const double& val)      { ry = val; }
-        void Flip(void)   { y = (-1) * y - height; }
-        void Mirror(void) { x = (-1) * x - width; }
-        void Rot90();  // rotate clockwise by 90°
-        void Scale(const double& factX=1.0, const double& factY=1.0) {
-                       x     *= factX;      y *= factY;
-                       rx    *= factX;     ry *= factY;
-                       width *= factX; height *= factY;
+        void Transform(const AffineTransform& t) {
+                       t.ApplyToBox(x, y, width, height);
+                       t.ApplyToRadii(rx, ry);
                        }
-        std::string AsSVGstring(const size_t&);
+        void WriteSVG(SvgWriter&, const size_t&);
 };
 //
 //--- END - definition of class "ElmtRect" -------------------------------------
@@ -704,7 +822,10 @@ class ElmtArc : public BaseElement,
       double MaxX = -1e99;
       double MinY =  1e99;
       double MaxY = -1e99;
-      void DetermineMinMax();
+      // x, y, width, height, start, angle of the last "DetermineMinMax":
+      // "nan" never matches --> the first call always calculates
+      double MinMaxFor[6] = { NAN, NAN, NAN, NAN, NAN, NAN };
+      void DetermineMinMax();  // only, if the arc has changed
       //
    public:
       ElmtArc() : BaseElement("arc") {
@@ -717,24 +838,18 @@ class ElmtArc : public BaseElement,
       void Clear(void) { BasePosition::Clear(); BaseSize::Clear(); start = 0.0; angle = 0.0; }
       void ReadFromPugiNode(pugi::xml_node&);
       void WriteToPugiNode(pugi::xml_node&, const size_t&);
-      double GetMinX() { return MinX; }
-      double GetMaxX() { return MaxX; }
-      double GetMinY() { return MinY; }
-      double GetMaxY() { return MaxY; }
+      // bounding box: calculated when needed
+      double GetMinX() { DetermineMinMax(); return MinX; }
+      double GetMaxX() { DetermineMinMax(); return MaxX; }
+      double GetMinY() { DetermineMinMax(); return MinY; }
+      double GetMaxY() { DetermineMinMax(); return MaxY; }
       void SetData(const double&, const double&, const double&, const double&, const double&, const double&);
       void SetStart(const double& val) { start = val; Normalize(); }
       void SetAngle(const double& val) { angle = val; Normalize(); }
       void Normalize();
       void coutData(){ std::cout << x << "|" << y << ", " << width << "|" << height << ", " << start << "|" << angle; }
-      void Flip();   // vertikal
-      void Mirror(); // horizontal
-      void Rot90();  // rotate clockwise by 90°
-      void Scale(const double& factX=1.0, const double& factY=1.0) {
-                       x     *= factX;      y *= factY;
-                       width *= factX; height *= factY;
-                       DetermineMinMax();
-                       }
-      std::string AsSVGstring(const size_t&);
+      void Transform(const AffineTransform&);
+      void WriteSVG(SvgWriter&, const size_t&);
 };
 //
 //--- END - definition of class "ElmtArc" --------------------------------------
@@ -763,7 +878,7 @@ class ElmtTerminal : public BaseElement,
       void Clear(void) { x = 0.0; y = 0.0; orientation = "n"; type = "Generic"; name = ""; uuid = ""; }
       void ReadFromPugiNode(pugi::xml_node&);
       void WriteToPugiNode(pugi::xml_node&);
-      void CreateNewUUID(void) { uuid = "{" + CreateUUID(false) + "}"; }
+      void CreateNewUUID(void) { uuid = CreateBracedUUID().c_str(); }
       std::string GetOrientation() { return orientation; }
       std::string GetType()        { return type; }
       std::string GetName()        { return name; }
@@ -772,17 +887,8 @@ class ElmtTerminal : public BaseElement,
       void SetType(const std::string& val)        { type = val; }
       void SetName(const std::string& val)        { name = val; }
       void SetUUID(const std::string& val)        { uuid = val; }
-      std::string AsSVGstring(const size_t&);
-      void Flip(void) { y *= (-1.0);
-                        if (orientation == "n") orientation = "s";
-                        if (orientation == "s") orientation = "n"; }   // vertikal
-      void Mirror(void) { x *= (-1.0);
-                        if (orientation == "e") orientation = "w";
-                        if (orientation == "w") orientation = "e"; }   // horizontal
-      void Rot90(void);  // rotate clockwise by 90°
-      void Scale(const double factX=1.0, const double factY=1.0){
-                        x *= factX; y *= factY;
-                        }
+      void WriteSVG(SvgWriter&, const size_t&);
+      void Transform(const AffineTransform&);
 };
 //
 //--- END - definition of class "ElmtTerminal" ---------------------------------
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "helpers.h"
+#include "fileio.h"
+
+#include <cstdlib>      // malloc, realloc, free
+#include <cstring>      // strerror
+#include <cerrno>       // errno
+#include <cstdio>       // fopen, fread for Windows
+#include <charconv>     // std::to_chars
+#include <algorithm>    // std::min
+
+#if defined(_WIN32)
+#include <io.h>         // _read
+#include <fcntl.h>      // _O_BINARY
+#elif defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <fcntl.h>      // open
+#include <unistd.h>     // read, close, sysconf
+#endif // Windows/Linux
+
+
+
+//
+//--- implementation of class "InputBuffer" ------------------------------------
+//
+void InputBuffer::Release(void) {
+#if defined(__linux__) || defined(__APPLE__)
+    if (xMapped) {
+        if (pData != nullptr) munmap(pData, nCapacity);
+    } else
+#endif // Linux
+    {
+        free(pData);
+    }
+    pData     = nullptr;
+    nSize     = 0;
+    nCapacity = 0;
+    xMapped   = false;
+}
+// ---
+// appends the '\0' to data in a malloc'ed buffer
+bool InputBuffer::Terminate(void) {
+    if (nSize >= nCapacity) {
+        char* pNew = (char*)realloc(pData, nSize + 1);
+        if (pNew == nullptr) {
+            sError = "out of memory";
+            return false;
+        }
+        pData = pNew;
+        nCapacity = nSize + 1;
+    }
+    pData[nSize] = '\0';
+    return true;
+}
+// ---
+// read everything from "fd" until EOF into a growing buffer
+bool InputBuffer::ReadFromFd(int fd) {
+    nCapacity = 64 * 1024;
+    pData = (char*)malloc(nCapacity);
+    if (pData == nullptr) {
+        sError = "out of memory";
+        return false;
+    }
+    for (;;) {
+        if (nSize == nCapacity) {
+            char* pNew = (char*)realloc(pData, nCapacity * 2);
+            if (pNew == nullptr) {
+                sError = "out of memory";
+                return false;
+            }
+            pData = pNew;
+            nCapacity *= 2;
+        }
+#if defined(_WIN32)
+        int n = _read(fd, pData + nSize, (unsigned int)(nCapacity - nSize));
+#else
+        ssize_t n = read(fd, pData + nSize, nCapacity - nSize);
+        if ((n < 0) && (errno == EINTR))
+            continue;
+#endif // Windows/Linux
+        if (n < 0) {
+            sError = strerror(errno);
+            return false;
+        }
+        if (n == 0)
+            return Terminate();  // EOF
+        nSize += (size_t)n;
+    }
+}
+// ---
+bool InputBuffer::ReadStdIn(void) {
+    Release();
+#if defined(_WIN32)
+    _setmode(_fileno(stdin), _O_BINARY);
+    return ReadFromFd(_fileno(stdin));
+#else
+    return ReadFromFd(STDIN_FILENO);
+#endif // Windows/Linux
+}
+// ---
+bool InputBuffer::MapFile(const std::string& file) {
+    Release();
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        sError = strerror(errno);
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode)) {
+        // no regular file (e.g. a named pipe): read it the classic way
+        bool xOK = ReadFromFd(fd);
+        close(fd);
+        return xOK;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return Terminate();  // empty file: nothing to map - the parser reports the error
+    }
+    // first reserve zeroed memory for the file AND the '\0' behind it, then
+    // map the file over it: the rest of the last page is zero, too
+    const size_t nPage = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t nFile = (size_t)st.st_size;
+    const size_t nMap  = ((nFile + 1 + nPage - 1) / nPage) * nPage;
+    void* p = mmap(nullptr, nMap, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        sError = strerror(errno);
+        close(fd);
+        return false;
+    }
+    // "private" and writable: the in-place-parser modifies the pages,
+    // only these pages are copied - the file itself remains unchanged
+    if (mmap(p, nFile, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        sError = strerror(errno);
+        munmap(p, nMap);
+        close(fd);
+        return false;
+    }
+    close(fd);
+    madvise(p, nFile, MADV_SEQUENTIAL);
+    pData     = (char*)p;
+    nSize     = nFile;
+    nCapacity = nMap;
+    xMapped   = true;
+    return true;
+#else
+    // no "mmap": read the file into the buffer
+    FILE* f = fopen(file.c_str(), "rb");
+    if (f == nullptr) {
+        sError = strerror(errno);
+        return false;
+    }
+    bool xOK = ReadFromFd(_fileno(f));
+    fclose(f);
+    return xOK;
+#endif // Linux
+}
+// ---
+void InputBuffer::Prefetch(void) {
+#if defined(__linux__) || defined(__APPLE__)
+    if (!xMapped || (pData == nullptr))
+        return;
+    // reading one byte per page loads the file from disk now and not
+    // later while parsing
+    const size_t nPage = (size_t)sysconf(_SC_PAGESIZE);
+    volatile char c = 0;
+    for (size_t i = 0; i < nSize; i += nPage)
+        c = c + pData[i];
+    (void)c;
+#endif // Linux
+}
+//
+//--- END - implementation of class "InputBuffer" ------------------------------
+//
+
+
+
+//
+//--- implementation of class "QetXmlWriter" -----------------------------------
+//
+void QetXmlWriter::write(const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    for (size_t i = 0; i < size; i++)
+        Filter(p[i]);
+}
+// ---
+// step 1: remove all spaces in front of "/>\n"
+void QetXmlWriter::Filter(const char c) {
+    if (nSlash == 0) {
+        if (c == ' ') {
+            nSpaces++;
+            return;
+        }
+        if ((c == '/') && (nSpaces > 0)) {
+            nSlash = 1;
+            return;
+        }
+        FlushFilter();
+        Replace(c);
+        return;
+    }
+    if ((nSlash == 1) && (c == '>')) {
+        nSlash = 2;
+        return;
+    }
+    if ((nSlash == 2) && (c == '\n')) {
+        nSpaces = 0;  // drop the spaces
+        nSlash  = 0;
+        Replace('/');
+        Replace('>');
+        Replace('\n');
+        return;
+    }
+    // no match: the held back chars are written and "c" starts again
+    FlushFilter();
+    Filter(c);
+}
+// ---
+void QetXmlWriter::FlushFilter(void) {
+    for (; nSpaces > 0; nSpaces--)
+        Replace(' ');
+    if (nSlash > 0) Replace('/');
+    if (nSlash > 1) Replace('>');
+    nSlash = 0;
+}
+// ---
+// step 2: "<text/>" -> "<text></text>"
+void QetXmlWriter::Replace(const char c) {
+    static const char sText[] = "<text/>";
+    if (c == sText[nText]) {
+        nText++;
+        if (nText == (sizeof(sText) - 1)) {
+            Emit("<text></text>", 13);
+            nText = 0;
+        }
+        return;
+    }
+    // "<" is only at the beginning of the pattern: write what was held
+    // back and maybe start again with "c"
+    FlushReplace();
+    if (c == '<')
+        nText = 1;
+    else
+        Emit(c);
+}
+// ---
+void QetXmlWriter::FlushReplace(void) {
+    Emit("<text/>", nText);
+    nText = 0;
+}
+// ---
+void QetXmlWriter::FlushBlock(void) {
+    if (nBlock == 0)
+        return;
+    if (pString != nullptr) {
+        pString->append(block, nBlock);
+    } else if (pFile != nullptr) {
+        if (fwrite(block, 1, nBlock, pFile) != nBlock)
+            xError = true;
+    }
+    nBlock = 0;
+}
+// ---
+bool QetXmlWriter::Flush(void) {
+    FlushFilter();
+    FlushReplace();
+    FlushBlock();
+    if ((pFile != nullptr) && (fflush(pFile) != 0))
+        xError = true;
+    return !xError;
+}
+//
+//--- END - implementation of class "QetXmlWriter" -----------------------------
+//
+
+
+
+//
+//--- implementation of class "SvgWriter" --------------------------------------
+//
+void SvgWriter::FlushBlock(void) {
+    if (nBlock == 0)
+        return;
+    if (pString != nullptr) {
+        pString->append(block, nBlock);
+    } else if (pFile != nullptr) {
+        if (fwrite(block, 1, nBlock, pFile) != nBlock)
+            xError = true;
+    }
+    nBlock = 0;
+}
+// ---
+SvgWriter& SvgWriter::operator<<(std::string_view s) {
+    while (s.length() > 0) {
+        if (nBlock == nBlockSize) FlushBlock();
+        const size_t n = std::min(s.length(), nBlockSize - nBlock);
+        memcpy(block + nBlock, s.data(), n);
+        nBlock += n;
+        s.remove_prefix(n);
+    }
+    return *this;
+}
+// ---
+SvgWriter& SvgWriter::Num(const double value, const size_t dec) {
+    if ((nBlockSize - nBlock) < nMaxNumber) FlushBlock();
+    char* pEnd = FormatValueTo(block + nBlock, block + nBlockSize, value, dec);
+    if (pEnd != nullptr)
+        nBlock = (size_t)(pEnd - block);
+    else
+        *this << FormatValue(value, dec);  // very many decimals...
+    return *this;
+}
+// ---
+SvgWriter& SvgWriter::Int(const long long value) {
+    char buf[24];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    return *this << std::string_view(buf, (size_t)(res.ptr - buf));
+}
+// ---
+SvgWriter& SvgWriter::Text(std::string_view s) {
+    static const char tab[] = "0123456789abcdef";
+    for (const char c : s) {
+        switch (c) {
+            case '&' :
+            case '>' :
+            case '<' :
+            case '"' :
+            case '\'':
+                *this << "&#x" << tab[((unsigned char)c) >> 4] << tab[((unsigned char)c) & 0x0f] << ';';
+                break;
+            default:
+                *this << c;
+        }
+    }
+    return *this;
+}
+// ---
+SvgWriter& SvgWriter::Attrs(std::string_view attrs) {
+    if (pClasses == nullptr)
+        return *this << attrs;
+    // the spaces behind the attributes stay where they are
+    const size_t len = attrs.find_last_not_of(' ') + 1;
+    *this << "class=\"s";
+    Int((long long)pClasses->Lookup(attrs.substr(0, len))) << '"';
+    return *this << attrs.substr(len);
+}
+// ---
+SvgWriter& SvgWriter::MarkerRef(std::string_view name, std::string_view def) {
+    *this << name << "=\"url(#m";
+    return Int((long long)pMarkers->Lookup(def)) << ")\" ";
+}
+// ---
+bool SvgWriter::Flush(void) {
+    FlushBlock();
+    if ((pFile != nullptr) && (fflush(pFile) != 0))
+        xError = true;
+    return !xError;
+}
+//
+//--- END - implementation of class "SvgWriter" --------------------------------
+//
+
+
+
+
+//
+//--- implementation of class "SvgClasses" -------------------------------------
+//
+size_t SvgClasses::Lookup(std::string_view attrs) {
+    // only a few different styles in an element: a simple search is enough
+    for (size_t i = 0; i < vsAttrs.size(); i++)
+        if (vsAttrs[i] == attrs) return i;
+    vsAttrs.emplace_back(attrs);
+    return vsAttrs.size() - 1;
+}
+// ---
+// 'stroke-width="1" fill="none"' --> ".s0 { stroke-width:1; fill:none; }"
+void SvgClasses::WriteStyle(SvgWriter& w) const {
+    w << "    <style>\n";
+    for (size_t i = 0; i < vsAttrs.size(); i++) {
+        w << "      .s"; w.Int((long long)i) << " {";
+        std::string_view attrs = vsAttrs[i];
+        while (true) {
+            const size_t posEq  = attrs.find("=\"");
+            if (posEq == std::string_view::npos) break;
+            const size_t posEnd = attrs.find('"', posEq + 2);
+            if (posEnd == std::string_view::npos) break;
+            const size_t posName = attrs.find_first_not_of(' ');
+            w << ' ' << attrs.substr(posName, posEq - posName) << ':'
+                     << attrs.substr(posEq + 2, posEnd - posEq - 2) << ';';
+            attrs.remove_prefix(posEnd + 1);
+        }
+        w << " }\n";
+    }
+    w << "    </style>\n";
+}
+//
+//--- END - implementation of class "SvgClasses" -------------------------------
+//
+
+
+
+
+//
+//--- implementation of class "SvgMarkers" -------------------------------------
+//
+size_t SvgMarkers::Lookup(std::string_view def) {
+    for (size_t i = 0; i < vsDefs.size(); i++)
+        if (vsDefs[i] == def) return i;
+    vsDefs.emplace_back(def);
+    return vsDefs.size() - 1;
+}
+// ---
+void SvgMarkers::WriteDefs(SvgWriter& w) const {
+    for (size_t i = 0; i < vsDefs.size(); i++) {
+        w << "    <marker id=\"m"; w.Int((long long)i) << "\" " << vsDefs[i];
+        w << "    </marker>\n";
+    }
+}
+//
+//--- END - implementation of class "SvgMarkers" -------------------------------
+//
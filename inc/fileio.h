@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FILEIO_H
+#define FILEIO_H
+
+#include <cstdint>      // int8_t, ...
+#include <string>       // we handle strings here
+#include <cstdio>       // FILE*
+#include <string_view>  // text for the SVG
+#include <vector>       // classes of the SVG
+
+#include "pugixml/pugixml.hpp"
+
+
+//
+//--- definition of class "InputBuffer" ----------------------------------------
+//
+// holds the raw input-data for pugixml's "load_buffer_inplace": the
+// document points into this buffer, so it has to live longer than the
+// document! Files are memory-mapped (private: the parser may write into
+// the pages without changing the file), stdin is read into one growable
+// buffer without iostreams.
+// The data is always followed by a '\0' - like pugixml's own buffers of
+// "load_file" and "load(stream)": "ParseSize()" includes it, so the parser
+// sees exactly the same data (and reports the same errors) as before.
+//
+class InputBuffer {
+    private:
+      char*  pData    = nullptr;
+      size_t nSize    = 0;
+      size_t nCapacity = 0;     // allocated or mapped bytes
+      bool   xMapped  = false;  // "true": release with "munmap", else "free"
+      std::string sError = "";
+      bool ReadFromFd(int fd);
+      bool Terminate(void);
+      //
+    public:
+      InputBuffer() {}
+      ~InputBuffer() { Release(); }
+      InputBuffer(const InputBuffer&) = delete;
+      InputBuffer& operator=(const InputBuffer&) = delete;
+      bool MapFile(const std::string& file);  // "false" -> see "Error()"
+      bool ReadStdIn(void);                   // "false" -> see "Error()"
+      void Prefetch(void);                    // touch all pages of the mapping
+      void Release(void);
+      char*  Data(void)  { return pData; }
+      size_t Size(void)  const { return nSize; }
+      size_t ParseSize(void) const { return nSize + 1; }  // with '\0' 
+      const std::string& Error(void) const { return sError; }
+};
+//
+//--- END - definition of class "InputBuffer" ----------------------------------
+//
+
+
+
+//
+//--- definition of class "QetXmlWriter" ---------------------------------------
+//
+// a "pugi::xml_writer" that makes the XML look like the one of QET while
+// writing - no technical reason, only for the look ("You said, nothing
+// changed, but look here..."):
+//   " />\n"   ->  "/>\n"          (all spaces in front of "/>\n")
+//   "<text/>" ->  "<text></text>"
+// The result is collected in blocks and written to a FILE* (file or stdout)
+// or appended to a string (pipeline). Linear time, constant memory.
+//
+class QetXmlWriter : public pugi::xml_writer {
+    private:
+      static const size_t nBlockSize = 64 * 1024;
+      FILE*        pFile   = nullptr;
+      std::string* pString = nullptr;
+      char   block[nBlockSize];
+      size_t nBlock  = 0;
+      bool   xError  = false;
+      // state of the replacements:
+      size_t nSpaces = 0;  // spaces held back: maybe in front of "/>\n"
+      size_t nSlash  = 0;  // 1: "/" or 2: "/>" held back behind the spaces
+      size_t nText   = 0;  // number of chars of "<text/>" held back
+      void Filter(const char c);   // the spaces in front of "/>\n"
+      void Replace(const char c);  // "<text/>"
+      void FlushFilter(void);
+      void FlushReplace(void);
+      void Emit(const char c) {
+          if (nBlock == nBlockSize) FlushBlock();
+          block[nBlock++] = c;
+      }
+      void Emit(const char* s, size_t n) { while (n-- > 0) Emit(*s++); }
+      void FlushBlock(void);
+      //
+    public:
+      explicit QetXmlWriter(FILE* f) : pFile(f) {}
+      explicit QetXmlWriter(std::string& s) : pString(&s) {}
+      ~QetXmlWriter() { Flush(); }
+      QetXmlWriter(const QetXmlWriter&) = delete;
+      QetXmlWriter& operator=(const QetXmlWriter&) = delete;
+      void write(const void* data, size_t size) override;
+      bool Flush(void);  // writes everything held back; "false" on write-error
+};
+//
+//--- END - definition of class "QetXmlWriter" ---------------------------------
+//
+
+
+
+
+
+//
+//--- definition of class "SvgClasses" -----------------------------------------
+//
+// "--svg-classes": the distinct combinations of style-attributes of an
+// element - they are written once as CSS-rules into a "<style>" and the
+// primitives only get a "class"
+//
+class SvgWriter;
+class SvgClasses {
+    private:
+      std::vector<std::string> vsAttrs;  // in the order of first use
+    public:
+      // index of the class for "attrs" (e.g. 'stroke-width="1" fill="none"'):
+      size_t Lookup(std::string_view attrs);
+      size_t Size(void) const { return vsAttrs.size(); }
+      void WriteStyle(SvgWriter& w) const;  // the "<style>"-block
+};
+//
+//--- END - definition of class "SvgClasses" -----------------------------------
+//
+
+
+
+
+
+//
+//--- definition of class "SvgMarkers" -----------------------------------------
+//
+// "--svg-markers": the distinct ends of lines (kind, length, style) of an
+// element as "<marker>"-definitions - the lines only reference them
+//
+class SvgMarkers {
+    private:
+      std::vector<std::string> vsDefs;  // attributes and content of "<marker>"
+    public:
+      size_t Lookup(std::string_view def);
+      size_t Size(void) const { return vsDefs.size(); }
+      void WriteDefs(SvgWriter& w) const;   // all "<marker>" for "<defs>"
+};
+//
+//--- END - definition of class "SvgMarkers" -----------------------------------
+//
+
+
+
+
+
+//
+//--- definition of class "SvgWriter" ------------------------------------------
+//
+// collects the SVG of an element in blocks and writes it to a FILE* (file
+// or stdout) or appends it to a string (pipeline) - like "QetXmlWriter";
+// the numbers are formatted directly into the block: no temporary strings
+//
+class SvgWriter {
+    private:
+      static const size_t nBlockSize = 64 * 1024;
+      static const size_t nMaxNumber = 400;  // max. length of a formatted double
+      FILE*        pFile   = nullptr;
+      std::string* pString = nullptr;
+      char   block[nBlockSize];
+      size_t nBlock  = 0;
+      bool   xError  = false;
+      SvgClasses* pClasses = nullptr;
+      SvgMarkers* pMarkers = nullptr;
+      void FlushBlock(void);
+      //
+    public:
+      explicit SvgWriter(FILE* f) : pFile(f) {}
+      explicit SvgWriter(std::string& s) : pString(&s) {}
+      ~SvgWriter() { Flush(); }
+      SvgWriter(const SvgWriter&) = delete;
+      SvgWriter& operator=(const SvgWriter&) = delete;
+      SvgWriter& operator<<(const char c) {
+          if (nBlock == nBlockSize) FlushBlock();
+          block[nBlock++] = c;
+          return *this;
+      }
+      SvgWriter& operator<<(std::string_view s);
+      SvgWriter& Num(const double value, const size_t dec);  // like "FormatValue"
+      SvgWriter& Int(const long long value);
+      SvgWriter& Text(std::string_view s);                   // like "TextToEntity"
+      // style-attributes: as they are or as "class" (with "UseClasses")
+      SvgWriter& Attrs(std::string_view attrs);
+      void UseClasses(SvgClasses* p) { pClasses = p; }
+      bool HasClasses(void) const { return (pClasses != nullptr); }
+      // reference to a marker (with "UseMarkers"): 'NAME="url(#mN)" '
+      SvgWriter& MarkerRef(std::string_view name, std::string_view def);
+      void UseMarkers(SvgMarkers* p) { pMarkers = p; }
+      bool HasMarkers(void) const { return (pMarkers != nullptr); }
+      bool Flush(void);  // writes everything; "false" on write-error
+};
+//
+//--- END - definition of class "SvgWriter" ------------------------------------
+//
+
+
+#endif  //#ifndef FILEIO_H
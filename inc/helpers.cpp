@@ -30,18 +30,18 @@
 #include "helpers.h"
 
 #include <random>       // for random values of uuid
+#include <thread>       // seed of the uuid-generator per thread
+#include <chrono>       // seed of the uuid-generator
 #include <cmath>        // for sqrt, atan2, isnan(), ...
 #include <iomanip>      // for IO-Operations
 #include <fstream>      // for file-reading
 #include <sstream>      // for String-Streams
 #include <regex>        // for "double"-Check
+#include <charconv>     // for "to_chars" and "from_chars"
+#include <cstring>      // for strlen
 
 
 const char cDecSep = '.';     // Decimal-Separator for values in output-file
-// for setting a (new) Decimal-Separator
-struct DecSep : std::numpunct<char> {
-    char do_decimal_point()   const { return cDecSep; }  // Decimal-Separator
-};
 
 
 
@@ -50,9 +50,40 @@ struct DecSep : std::numpunct<char> {
 /******************************************************************************/
 /******************************************************************************/
 /******************************************************************************/
-std::string FormatValue(const double value, const size_t dec){
+// the rounded value "iVal" with "dec" decimals: iVal / 10^dec
+static char* WriteFixed(char* first, char* last, long int iVal, const size_t dec) {
+    char digits[24];  // the digits of |iVal| from right to left
+    size_t n = 0;
+    unsigned long int u = (iVal < 0) ? (0UL - (unsigned long int)iVal) : (unsigned long int)iVal;
+    do {
+        digits[n++] = char('0' + (u % 10));
+        u /= 10;
+    } while (u > 0);
+    while (n <= dec)
+        digits[n++] = '0';  // at least one digit in front of the separator
+    // trailing zeros of the decimals are not needed
+    size_t nSkip = 0;
+    while ((nSkip < dec) && (digits[nSkip] == '0'))
+        nSkip++;
+    size_t nLength = (iVal < 0 ? 1 : 0) + (n - dec) + ((nSkip < dec) ? (1 + dec - nSkip) : 0);
+    if ((size_t)(last - first) < nLength)
+        return nullptr;
+    if (iVal < 0)
+        *first++ = '-';
+    for (size_t i = n; i > dec; i--)
+        *first++ = digits[i-1];
+    if (nSkip < dec) {
+        *first++ = cDecSep;
+        for (size_t i = dec; i > nSkip; i--)
+            *first++ = digits[i-1];
+    }
+    return first;
+}
+// ---
+char* FormatValueTo(char* first, char* last, const double value, const size_t dec) {
     if (dec == 0) {
-        return std::to_string(int(std::round(value)));
+        std::to_chars_result res = std::to_chars(first, last, int(std::round(value)));
+        return (res.ec == std::errc()) ? res.ptr : nullptr;
     }
     double val = value;
     double epsilon = 0.1; // too small values will be set to "0"
@@ -69,13 +100,16 @@ std::string FormatValue(const double value, const size_t dec){
         val = (val * 10.0);
     long int iVal = round(val);
     // we're done, if "0"
-    if (iVal == 0)
-        return "0";
+    if (iVal == 0) {
+        if (first == last) return nullptr;
+        *first = '0';
+        return first + 1;
+    }
     // additional rounding, if value is VERY close to the next integer:
     if (dec>1) {
-        int Divider = 1;
+        int64_t Divider = 1;
         for (size_t i=0; i<dec; i++) Divider *= 10;
-        int Rest = iVal % Divider;
+        int64_t Rest = iVal % Divider;
         if (((Rest > 0) && (Rest <  5)) || ((Rest < 0) && (Rest > -5))) {
             if (_DEBUG_) std::cerr << "Divider: " << Divider << " - Rest: " << Rest
                               << " - subtract " << Rest << std::endl;
@@ -93,26 +127,49 @@ std::string FormatValue(const double value, const size_t dec){
             }
     }
 
-    // prepare to return the new value as string
+    // the usual coordinates are written directly with integer-math: the
+    // digits of "iVal" are the result - "dVal" below would round to them
+    if ((iVal > -100000000000000L) && (iVal < 100000000000000L) && (dec < 18))
+        return WriteFixed(first, last, iVal, dec);
+
+    // huge values: calculate "dVal" as before and let "to_chars" round it
     double dVal = iVal;
     for (size_t i=0; i<dec; i++)
         dVal = (dVal / 10.0);
-    std::stringstream ss;
-    ss.imbue(std::locale(std::cout.getloc(), new DecSep));
-    ss << std::fixed << std::setprecision(dec) << dVal;
-    std::string s = ss.str();  // "s" is number always (!) with decimals
-    // delete this range of characters in order from the end of string:
-    const char chars[] = {'0', cDecSep};
-    // use range for loop to print array elements
-    for (char c : chars)
-        while (s[s.length()-1] == c) {
-            if (_DEBUG_)
-                std::cerr << "del \"" << c << "\"" << std::endl;
-            s.erase(s.length()-1, 1);
-        }
-
+    std::to_chars_result res = std::to_chars(first, last, dVal, std::chars_format::fixed, (int)dec);
+    if (res.ec != std::errc())
+        return nullptr;
+    // "res" is number always (!) with decimals: delete zeros and separator
+    char* end = res.ptr;
+    while (*(end-1) == '0') end--;
+    if (*(end-1) == cDecSep) end--;
+    return end;
+}
+// ---
+std::string FormatValue(const double value, const size_t dec){
+    char buf[384];
+    char* end = FormatValueTo(buf, buf + sizeof(buf), value, dec);
+    if (end != nullptr)
+        return std::string(buf, end);
+    // really a lot of decimals: use a bigger buffer
+    std::string s(dec + 400, '\0');
+    end = FormatValueTo(&s[0], &s[0] + s.size(), value, dec);
+    s.resize((end != nullptr) ? (end - &s[0]) : 0);
     return s;
 }
+// ---
+char* FormatValues(char* first, char* last, const double* values, const size_t count,
+                   const size_t dec, const char sep) {
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            if (first == last) return nullptr;
+            *first++ = sep;
+        }
+        first = FormatValueTo(first, last, values[i], dec);
+        if (first == nullptr) return nullptr;
+    }
+    return first;
+}
 /******************************************************************************/
 /******************************************************************************/
 /******************************************************************************/
@@ -201,35 +258,154 @@ void replaceAll(      std::string& str,   // in-place - replacement!
 // ###               we build a (random?) UUID                 ###
 // ###############################################################
 //
-static unsigned int random_char() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 255);
-    return dis(gen);
+// one generator per thread: "xoshiro256**", seeded once from "random_device"
+// (via "splitmix64") - no syscall and no "mt19937"-state per UUID
+static uint64_t SplitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
 }
 //
-static std::string generate_hex(const unsigned int len) {
-    std::string s = "";
-    for (unsigned int i = 0; i < len; i++) {
-        const uint8_t rc = random_char();
-        s += toHex<uint8_t>(rc); // eigene Funktion ...
+static inline uint64_t RotL(const uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+}
+//
+class UUIDRandom {
+    private:
+      uint64_t s[4];
+    public:
+      UUIDRandom() {
+          std::random_device rd;
+          uint64_t seed = ((uint64_t)rd() << 32) ^ (uint64_t)rd();
+          // different threads never get the same state, even with a weak "random_device"
+          seed ^= (uint64_t)std::hash<std::thread::id>{}(std::this_thread::get_id());
+          seed ^= (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+          for (auto& v : s) v = SplitMix64(seed);
+      }
+      uint64_t Next(void) {
+          const uint64_t result = RotL(s[1] * 5, 7) * 9;
+          const uint64_t t = s[1] << 17;
+          s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+          s[2] ^= t;
+          s[3] = RotL(s[3], 45);
+          return result;
+      }
+};
+//
+// "--uuid-mode=hash": the state of the thread while an "UUIDHashScope" lives
+struct UUIDHashState {
+    bool        xActive = false;
+    std::string name;
+    uint64_t    counter = 0;
+};
+static thread_local UUIDHashState HashState;
+//
+// SHA-1 (RFC 3174) - only for the version-5 UUIDs (RFC 4122, 4.3)
+static void SHA1(const uint8_t* data, const size_t len, uint8_t (&digest)[20]) {
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    auto rol = [](const uint32_t x, const int k) { return (x << k) | (x >> (32 - k)); };
+    // the message with padding: "0x80", zeros and the length in bits
+    std::string msg((const char*)data, len);
+    msg += (char)0x80;
+    while ((msg.length() % 64) != 56) msg += (char)0x00;
+    const uint64_t bits = (uint64_t)len * 8;
+    for (int i = 7; i >= 0; i--) msg += (char)((bits >> (8 * i)) & 0xFF);
+    for (size_t blk = 0; blk < msg.length(); blk += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++)
+            w[i] = ((uint32_t)(uint8_t)msg[blk + 4*i    ] << 24) | ((uint32_t)(uint8_t)msg[blk + 4*i + 1] << 16) |
+                   ((uint32_t)(uint8_t)msg[blk + 4*i + 2] <<  8) |  (uint32_t)(uint8_t)msg[blk + 4*i + 3];
+        for (int i = 16; i < 80; i++)
+            w[i] = rol(w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1);
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if      (i < 20) { f = (b & c) | (~b & d);          k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+            const uint32_t t = rol(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rol(b, 30); b = a; a = t;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
     }
-    return s;
+    for (int i = 0; i < 20; i++)
+        digest[i] = (uint8_t)(h[i / 4] >> (24 - 8 * (i % 4)));
+}
+//
+// version 5: SHA-1 of namespace and name
+static void UUIDv5(const uint8_t (&ns)[16], const std::string& name, uint8_t (&uuid)[16]) {
+    std::string data((const char*)ns, 16);
+    data += name;
+    uint8_t digest[20];
+    SHA1((const uint8_t*)data.data(), data.length(), digest);
+    for (int i = 0; i < 16; i++) uuid[i] = digest[i];
+    uuid[6] = (uuid[6] & 0x0F) | 0x50;   // version 5
+    uuid[8] = (uuid[8] & 0x3F) | 0x80;   // variant
+}
+//
+// the namespace of this program: v5 of "NameSpace_URL" with the URL of the project
+static const uint8_t (&HashNamespace(void))[16] {
+    static const uint8_t nsURL[16] = { 0x6b, 0xa7, 0xb8, 0x11, 0x9d, 0xad, 0x11, 0xd1,
+                                       0x80, 0xb4, 0x00, 0xc0, 0x4f, 0xd4, 0x30, 0xc8 };
+    static const struct NS {
+        uint8_t u[16];
+        NS() { UUIDv5(nsURL, "https://github.com/plc-user/QET_ElementScaler", u); }
+    } ns;
+    return ns.u;
+}
+//
+UUIDHashScope::UUIDHashScope(const bool xActive, const std::string& name)
+    : xPrevActive(HashState.xActive), sPrevName(HashState.name), nPrevCounter(HashState.counter) {
+    HashState.xActive = xActive;
+    HashState.name    = name;
+    HashState.counter = 0;
+}
+//
+UUIDHashScope::~UUIDHashScope() {
+    HashState.xActive = xPrevActive;
+    HashState.name    = sPrevName;
+    HashState.counter = nPrevCounter;
+}
+//
+// version 4 (random), variant "10xx": "{xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx}"
+// or version 5 (hash) within an "UUIDHashScope"
+UUIDString CreateBracedUUID(const bool UpCase) {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    if (HashState.xActive) {
+        // the running number makes the UUIDs of one element different
+        uint8_t u[16];
+        UUIDv5(HashNamespace(), HashState.name + "#" + std::to_string(HashState.counter++), u);
+        for (int i = 0; i < 8; i++) {
+            hi = (hi << 8) | u[i];
+            lo = (lo << 8) | u[i + 8];
+        }
+    } else {
+        static thread_local UUIDRandom rng;
+        hi = rng.Next();
+        lo = rng.Next();
+        hi = (hi & 0xFFFFFFFFFFFF0FFFull) | 0x0000000000004000ull;   // version 4
+        lo = (lo & 0x3FFFFFFFFFFFFFFFull) | 0x8000000000000000ull;   // variant
+    }
+    const char* digits = (UpCase ? "0123456789ABCDEF" : "0123456789abcdef");
+    UUIDString u;
+    char* p = u.c;
+    *p++ = '{';
+    for (int i = 0; i < 32; i++) {
+        if ((i == 8) || (i == 12) || (i == 16) || (i == 20)) *p++ = '-';
+        const uint64_t v = (i < 16) ? hi : lo;
+        *p++ = digits[(v >> (60 - 4 * (i % 16))) & 0x0F];
+    }
+    *p++ = '}';
+    *p   = '\0';
+    return u;
 }
 //
 const std::string CreateUUID(const bool UpCase) {
-    std::string uuid = "";
-    uuid  =       generate_hex(4);
-    uuid += '-' + generate_hex(2);
-    uuid += '-' + generate_hex(2);
-    uuid += '-' + generate_hex(2);
-    uuid += '-' + generate_hex(6);
-    for (size_t i=0; i<uuid.length(); i++)
-        if (UpCase == true)
-            uuid[i] = toupper(uuid[i]);
-        else
-            uuid[i] = tolower(uuid[i]);
-    return uuid;
+    // without the braces:
+    return std::string(CreateBracedUUID(UpCase).c + 1, 36);
 }
 //
 // ###############################################################
@@ -238,6 +414,47 @@ const std::string CreateUUID(const bool UpCase) {
 //
 
 
+//
+// ###############################################################
+// ###       numbers and bools from attribute-values           ###
+// ###############################################################
+//
+double ParseDouble(const char* s) {
+    const char* p = s;
+    // like "strtod": leading whitespace and a "+" are allowed
+    while ((*p == ' ') || ((*p >= '\t') && (*p <= '\r')))
+        p++;
+    const char* q = p;
+    if (*q == '+') {
+        q++;
+        if ((*q == '+') || (*q == '-'))
+            return 0.0;
+    }
+    const char* d = (*q == '-') ? (q + 1) : q;
+    // hexadecimal numbers only with "strtod"
+    if ((d[0] == '0') && ((d[1] == 'x') || (d[1] == 'X')))
+        return strtod(s, nullptr);
+    double val = 0.0;
+    std::from_chars_result res = std::from_chars(q, q + strlen(q), val);
+    if (res.ec == std::errc::invalid_argument)
+        return 0.0;
+    if (res.ec != std::errc())
+        return strtod(s, nullptr);  // out of range: "strtod" knows what to do
+    return val;
+}
+// ---
+bool ParseBool(const char* s) {
+    // only look at first char: 1*, t* (true), T* (True), y* (yes), Y* (YES)
+    return ((s[0] == '1') || (s[0] == 't') || (s[0] == 'T') || (s[0] == 'y') || (s[0] == 'Y'));
+}
+//
+// ###############################################################
+// ###     END: numbers and bools from attribute-values        ###
+// ###############################################################
+//
+
+
+
 //
 // ###############################################################
 // ###     does the string contain a double- or int-value      ###
@@ -49,11 +49,37 @@
 // --- function-prototype for formatted double-to-string -----------------------
 //
 std::string FormatValue(const double, const size_t);
+// the same without allocation: writes to [first, last) and returns the new
+// end - or "nullptr", if the buffer is too small
+char* FormatValueTo(char* first, char* last, const double value, const size_t dec);
+// "count" values, separated by "sep"
+char* FormatValues(char* first, char* last, const double* values, const size_t count,
+                   const size_t dec, const char sep = ' ');
 
 //
 // --- function-prototype for UUID-calculation ---------------------------------
 //
 const std::string CreateUUID(bool UpCase=false);
+// the same with braces in a fixed buffer: "{...}" and '\0'
+struct UUIDString {
+    char c[39];
+    const char* c_str(void) const { return c; }
+};
+UUIDString CreateBracedUUID(bool UpCase=false);
+// "--uuid-mode=hash": while the scope lives, the thread creates version-5
+// UUIDs from "name" and a running number - same input, same UUIDs; scopes
+// can be nested: the outer one continues after the end of the inner one
+class UUIDHashScope {
+    private:
+      bool        xPrevActive;
+      std::string sPrevName;
+      uint64_t    nPrevCounter;
+    public:
+      UUIDHashScope(const bool xActive, const std::string& name);
+      ~UUIDHashScope();
+      UUIDHashScope(const UUIDHashScope&) = delete;
+      UUIDHashScope& operator=(const UUIDHashScope&) = delete;
+};
 
 //
 // --- function-prototype for removing leading zeros ---------------------------
@@ -84,6 +110,15 @@ void replaceAll(      std::string& str,   // in-place - replacement!
 void CheckForDoubleString(std::string& s);
 
 
+//
+// --- numbers and bools from attribute-values ---------------------------------
+//
+// same results as pugixml's "as_double()" (strtod) and "as_bool()" - but
+// the usual decimal numbers are parsed with "std::from_chars"
+double ParseDouble(const char* s);
+bool ParseBool(const char* s);
+
+
 //
 // --- determine the geometry of the terminal ----------------------------------
 //
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "uuids.h"
+
+#include <algorithm>    // std::max
+
+
+
+//
+// ###############################################################
+// ###               a UUID as 128-bit value                   ###
+// ###############################################################
+//
+// value of a hex-digit or -1
+struct HexTable {
+    int8_t v[256];
+    constexpr HexTable() : v() {
+        for (int i = 0; i < 256; i++) v[i] = -1;
+        for (int i = 0; i < 10; i++) v['0' + i] = (int8_t)i;
+        for (int i = 0; i < 6; i++) { v['a' + i] = (int8_t)(10 + i); v['A' + i] = (int8_t)(10 + i); }
+    }
+};
+static constexpr HexTable Hex;
+// ---
+static uint64_t Mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+// ---
+UUID128 UUIDKey(std::string_view s) {
+    UUID128 key;
+    std::string_view v = s;
+    if ((v.length() == 38) && (v.front() == '{') && (v.back() == '}'))
+        v = v.substr(1, 36);
+    bool xValid = (v.length() == 36) && (v[8] == '-') && (v[13] == '-') && (v[18] == '-') && (v[23] == '-');
+    // the positions of the 32 digits: without the dashes
+    static constexpr uint8_t pos[32] = {  0,  1,  2,  3,  4,  5,  6,  7,  9, 10, 11, 12, 14, 15, 16, 17,
+                                         19, 20, 21, 22, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35 };
+    int bad = 0;
+    for (int i = 0; xValid && (i < 16); i++) {
+        const int dh = Hex.v[(uint8_t)v[pos[i]]];
+        const int dl = Hex.v[(uint8_t)v[pos[i + 16]]];
+        bad |= (dh | dl);
+        key.hi = (key.hi << 4) | (uint64_t)(dh & 0x0F);
+        key.lo = (key.lo << 4) | (uint64_t)(dl & 0x0F);
+    }
+    xValid = xValid && (bad >= 0);
+    if (xValid)
+        return key;
+    // no UUID: two different FNV-1a-hashes of the complete string
+    uint64_t h1 = 0xCBF29CE484222325ull;
+    uint64_t h2 = 0x84222325CBF29CE4ull;
+    for (const char c : s) {
+        h1 = (h1 ^ (uint8_t)c) * 0x100000001B3ull;
+        h2 = (h2 ^ (uint8_t)c) * 0x100000001B3ull;
+    }
+    return UUID128{ Mix64(h1), Mix64(h2 ^ s.length()) };
+}
+// ---
+// random UUIDs are already good hashes - but not every UUID is random
+static uint64_t HashKey(const UUID128& key) {
+    return Mix64(key.hi ^ (key.lo * 0x9E3779B97F4A7C15ull));
+}
+//
+// ###############################################################
+// ###             END: a UUID as 128-bit value                ###
+// ###############################################################
+//
+
+
+
+
+//
+//--- implementation of class "UUIDSet" ----------------------------------------
+//
+size_t UUIDSet::FindSlot(const UUID128& key) const {
+    const size_t mask = slots.size() - 1;
+    size_t i = (size_t)HashKey(key) & mask;
+    while (slots[i].used && !((slots[i].hi == key.hi) && (slots[i].lo == key.lo)))
+        i = (i + 1) & mask;
+    return i;
+}
+// ---
+void UUIDSet::Rehash(const size_t nSlots) {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.assign(nSlots, Slot{0, 0, 0, 0});
+    for (const Slot& s : old) {
+        if (s.used)
+            slots[FindSlot(UUID128{s.hi, s.lo})] = s;
+    }
+}
+// ---
+void UUIDSet::Reserve(const size_t nExpected) {
+    size_t nSlots = 16;
+    while (nSlots < 2 * nExpected) nSlots *= 2;
+    if (nSlots > slots.size())
+        Rehash(nSlots);
+}
+// ---
+bool UUIDSet::Insert(const UUID128& key, const uint32_t value, uint32_t* pOld) {
+    if (2 * (count + 1) > slots.size())
+        Rehash(std::max((size_t)16, 2 * slots.size()));
+    Slot& s = slots[FindSlot(key)];
+    if (s.used) {
+        if (pOld != nullptr) *pOld = s.value;
+        return false;
+    }
+    s = Slot{ key.hi, key.lo, value, 1 };
+    count++;
+    return true;
+}
+// ---
+bool UUIDSet::Find(const UUID128& key, uint32_t& value) const {
+    if (slots.empty())
+        return false;
+    const Slot& s = slots[FindSlot(key)];
+    if (s.used) value = s.value;
+    return (s.used != 0);
+}
+// ---
+bool UUIDSet::Erase(const UUID128& key) {
+    if (slots.empty())
+        return false;
+    const size_t mask = slots.size() - 1;
+    size_t i = FindSlot(key);
+    if (!slots[i].used)
+        return false;
+    // backward-shift: the following entries of the cluster move up, if the
+    // gap lies between their home-slot and their slot - no "deleted"-marks
+    for (size_t j = (i + 1) & mask; slots[j].used; j = (j + 1) & mask) {
+        const size_t home = (size_t)HashKey(UUID128{slots[j].hi, slots[j].lo}) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i].used = 0;
+    count--;
+    return true;
+}
+// ---
+void UUIDSet::Clear(void) {
+    // the slots stay allocated for the next file
+    for (Slot& s : slots) s.used = 0;
+    count = 0;
+}
+//
+//--- END - implementation of class "UUIDSet" ----------------------------------
+//
+
+
+
+
+//
+//--- implementation of class "UUIDIndex" --------------------------------------
+//
+UUIDIndex::UUIDIndex(const size_t nExpected) {
+    // evenly distributed over the shards: no rehash while running
+    for (Shard& sh : shards)
+        sh.set.Reserve(nExpected / nShards + 1);
+    files.reserve(nExpected);
+    fileIds.reserve(nExpected);
+}
+// ---
+// the upper bits select the shard, the lower ones the slot in the set
+UUIDIndex::Shard& UUIDIndex::ShardOf(const UUID128& key) {
+    return shards[HashKey(key) >> 58];
+}
+// ---
+bool UUIDIndex::Insert(std::string_view uuid, const std::string& sFile, std::string& sOther) {
+    const UUID128 key = UUIDKey(uuid);
+    uint32_t iFile = 0;
+    File old;
+    {
+        std::lock_guard<std::mutex> lockFiles(mtxFiles);
+        const auto res = fileIds.emplace(sFile, (uint32_t)files.size());
+        if (res.second)
+            files.push_back(File{ sFile, UUID128{}, false });
+        iFile = res.first->second;
+        old = files[iFile];
+        if (old.xOwner && !(old.key == key))
+            files[iFile].xOwner = false;
+    }
+    if (old.xOwner && !(old.key == key)) {
+        // the file has another UUID now: the old one is free again
+        Shard& shOld = ShardOf(old.key);
+        std::lock_guard<std::mutex> lock(shOld.mtx);
+        uint32_t iOwner = 0;
+        if (shOld.set.Find(old.key, iOwner) && (iOwner == iFile))
+            shOld.set.Erase(old.key);
+    }
+    Shard& sh = ShardOf(key);
+    std::lock_guard<std::mutex> lock(sh.mtx);
+    uint32_t iOther = 0;
+    if (sh.set.Find(key, iOther)) {
+        if (iOther == iFile)
+            return true;  // processed again
+        std::lock_guard<std::mutex> lockFiles(mtxFiles);
+        sOther = files[iOther].name;
+        return false;
+    }
+    sh.set.Insert(key, iFile);
+    std::lock_guard<std::mutex> lockFiles(mtxFiles);
+    files[iFile].key    = key;
+    files[iFile].xOwner = true;
+    return true;
+}
+// ---
+size_t UUIDIndex::Size(void) {
+    std::lock_guard<std::mutex> lock(mtxFiles);
+    return files.size();
+}
+// ---
+size_t UUIDIndex::Memory(void) {
+    size_t n = 0;
+    for (Shard& sh : shards) {
+        std::lock_guard<std::mutex> lock(sh.mtx);
+        n += sh.set.Memory();
+    }
+    return n;
+}
+//
+//--- END - implementation of class "UUIDIndex" --------------------------------
+//
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022-2025 plc-user
+ *
+ * It is NOT allowed to use this software or any of the
+ * associated files as sample data for the purposes of
+ * building machine learning models.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef UUIDS_H
+#define UUIDS_H
+
+#include <cstdint>      // uint64_t, ...
+#include <string>       // we handle strings here
+#include <string_view>  // the UUIDs of the nodes
+#include <vector>       // the slots of the hash-set
+#include <mutex>        // protect the shards of the index
+#include <unordered_map>  // the files of the index
+
+
+//
+// --- a UUID as 128-bit value -------------------------------------------------
+//
+struct UUID128 {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    bool operator==(const UUID128& o) const { return (hi == o.hi) && (lo == o.lo); }
+};
+// "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}" (braces optional, upper- or lower-
+// case); anything else is hashed to 128 bits, so it can be compared as well
+UUID128 UUIDKey(std::string_view s);
+
+
+//
+//--- definition of class "UUIDSet" --------------------------------------------
+//
+// flat hash-set of 128-bit UUIDs with open addressing (linear probing): one
+// allocation for all entries, at most half of the slots are used - so the
+// memory is between 48 and 96 bytes per UUID; every entry carries a 32-bit
+// value (e.g. the number of a file)
+//
+class UUIDSet {
+    private:
+      struct Slot {
+          uint64_t hi;
+          uint64_t lo;
+          uint32_t value;
+          uint32_t used;
+      };
+      std::vector<Slot> slots;  // the number is a power of 2
+      size_t count = 0;
+      size_t FindSlot(const UUID128& key) const;  // the key or the empty slot for it
+      void Rehash(const size_t nSlots);
+      //
+    public:
+      explicit UUIDSet(const size_t nExpected = 0) { Reserve(nExpected); }
+      void Reserve(const size_t nExpected);
+      // "true": new in the set; "false": already there - its value in "pOld"
+      bool Insert(const UUID128& key, const uint32_t value = 0, uint32_t* pOld = nullptr);
+      bool Find(const UUID128& key, uint32_t& value) const;
+      bool Erase(const UUID128& key);  // "false": was not in the set
+      size_t Size(void) const { return count; }
+      size_t Memory(void) const { return slots.size() * sizeof(Slot); }
+      void Clear(void);
+};
+//
+//--- END - definition of class "UUIDSet" --------------------------------------
+//
+
+
+
+//
+//--- definition of class "UUIDIndex" ------------------------------------------
+//
+// the element-UUIDs of all files of a batch-run: the worker-threads insert
+// concurrently - every one of the 64 shards has its own "UUIDSet" and lock;
+// a file owns at most one UUID: with a new one ("--watch") the old one is free
+//
+class UUIDIndex {
+    private:
+      static const size_t nShards = 64;
+      struct Shard {
+          std::mutex mtx;
+          UUIDSet    set;
+      };
+      struct File {
+          std::string name;
+          UUID128     key;
+          bool        xOwner = false;  // "key" is in the set with this file
+      };
+      Shard shards[nShards];
+      std::mutex mtxFiles;
+      std::vector<File> files;                             // the value in the sets
+      std::unordered_map<std::string, uint32_t> fileIds;   // name -> index in "files"
+      Shard& ShardOf(const UUID128& key);
+      //
+    public:
+      explicit UUIDIndex(const size_t nExpected = 0);
+      UUIDIndex(const UUIDIndex&) = delete;
+      UUIDIndex& operator=(const UUIDIndex&) = delete;
+      // "true": new or already owned by "sFile"; "false": used by the file "sOther"
+      bool Insert(std::string_view uuid, const std::string& sFile, std::string& sOther);
+      size_t Size(void);
+      size_t Memory(void);
+};
+//
+//--- END - definition of class "UUIDIndex" ------------------------------------
+//
+
+
+#endif  //#ifndef UUIDS_H
@@ -37,69 +37,130 @@
 #include <string>       // we handle strings here
 #include <getopt.h>     // for Commandline-Parameters
 #include <filesystem>   // for exe-filename
-#include <list>         // for list of UUIDs
+#include <atomic>       // counters for batch-mode
+#include <memory>       // files in the pipeline
+#include <chrono>       // occupancy of pipeline-stages
+#include <iomanip>      // statistics of the pipeline
 // project-includes
 #include "inc/pugixml/pugixml.hpp"
 #include "inc/helpers.h"
 #include "inc/elements.h"
+#include "inc/batch.h"
+#include "inc/fileio.h"
+#include "inc/arena.h"
+#include "inc/uuids.h"
 
 // =============================================================================
-// global variables
+// global constants
 // =============================================================================
 
-const std::string sVersion = "v0.5.5";
-
-// the element-file to process:
-static std::string ElementFile       = "";
-static std::string SVGFile           = "SampleFile.svg";
-static std::string ElementFileScaled = "SampleFile.SCALED.elmt";
-
-// we need a "Pugi-Node":
-static pugi::xml_node node;
-
-// some Bits for control
-static bool xIsElmtFile         = false;
-static bool xIsDirFile          = false;
-static bool xPrintHelp          = false;
-static bool xReadFromStdIn      = false;
-static bool xPrintToStdOut      = false;
-static bool xCreateSVG          = false;
-static bool xCreateELMT         = true;
-static bool xStopWithError      = false;
-static bool xScaleElement       = true;
-static bool xMoveElement        = false;
-static bool xRemoveAllTerminals = false;
-static bool xOverwriteOriginal  = false;
-static bool xFlipHor            = false;
-static bool xFlipVert           = false;
-static bool xRotate90           = false;
-static bool xOnlyCleanMeta      = false;
-
-// to find out, if we need to renew UUIDs for "dynamic_text" or "terminal":
-static std::list <std::string> lsUUIDsDynTexts;
-static std::list <std::string> lsUUIDsTerminals;
-static bool xTerminalsUUIDsUnique = true;
-static bool xDynTextsUUIDsUnique = true;
-
-// max. Number of decimals:
-static size_t decimals = 2;    // number of decimals for floating-point values
-static double MinLineLength = 0.025;  //
-
-static double scaleX = 1.0;
-static double scaleY = 1.0;
-
-static double moveX = 0.0;
-static double moveY = 0.0;
+const std::string sVersion = "v0.5.6";
+
+
+// =============================================================================
+// options and processing-context
+// =============================================================================
+
+//
+// all settings from the commandline: filled once by "parseCommandline"
+// and only read while processing -> can be shared by all worker-threads
+//
+struct ScaleOptions
+{
+    // the element-file to process:
+    std::string ElementFile    = "";
+    // some Bits for control
+    bool xPrintHelp          = false;
+    bool xReadFromStdIn      = false;
+    bool xPrintToStdOut      = false;
+    bool xCreateSVG          = false;
+    bool xCreateELMT         = true;
+    bool xStopWithError      = false;
+    bool xScaleElement       = true;
+    bool xMoveElement        = false;
+    bool xRemoveAllTerminals = false;
+    bool xOverwriteOriginal  = false;
+    bool xFlipHor            = false;
+    bool xFlipVert           = false;
+    bool xRotate90           = false;
+    bool xOnlyCleanMeta      = false;
+    bool xSimd               = false;  // points of lines and polygons in one buffer
+    bool xSvgClasses         = false;  // SVG: styles as CSS-classes in "<style>"
+    bool xSvgMarkers         = false;  // SVG: ends of lines as "<marker>"
+    bool xUuidHash           = false;  // new UUIDs from input and options (version 5)
+    UUIDIndex* pUuidIndex    = nullptr;  // batch-mode: the element-UUIDs of all files
+    bool xCache              = false;  // batch-mode: skip unchanged files
+    BatchCache* pCache       = nullptr;  // ... the cache-files of the directories
+    // batch-mode: all elements of a directory-tree are processed by worker-threads
+    std::string BatchDir     = "";
+    bool        xWatch       = false;  // keep on running and process changed files
+    size_t      iJobs        = 0;      // "0": determine automatically
+    // ... optionally as a pipeline: read -> parse -> transform -> serialize -> write
+    bool        xPipeline    = false;
+    size_t      iQueueDepth  = 8;      // max. number of files between two stages
+    // max. Number of decimals:
+    size_t decimals          = 2;      // number of decimals for floating-point values
+    double MinLineLength     = 0.025;  //
+    // scaling and moving:
+    double scaleX            = 1.0;
+    double scaleY            = 1.0;
+    double moveX             = 0.0;
+    double moveY             = 0.0;
+    // additional operations of "--op" in the order of the commandline:
+    std::vector<std::string> vsOps;
+    // all geometric operations composed into one matrix (see "BuildTransform"):
+    AffineTransform transform;
+};
+
+
+//
+// the state while processing ONE file: every job (and so every worker-thread)
+// has its own one - nothing is shared between jobs except the options
+//
+struct ElementJob
+{
+    const ScaleOptions& opt;
+    std::string sFile = "";
+    // what kind of data we have and what we create from it:
+    bool xIsElmt = false;
+    bool xIsDir  = false;
+    bool xToSVG  = false;
+    bool xToELMT = false;
+    std::string sOutFile = "";  // empty for output to stdout
+    // to find out, if we need to renew UUIDs for "dynamic_text" or "terminal":
+    UUIDSet setUUIDsDynTexts;
+    UUIDSet setUUIDsTerminals;
+    bool xTerminalsUUIDsUnique = true;
+    bool xDynTextsUUIDsUnique = true;
+    //
+    ElementJob(const ScaleOptions& o, const std::string& f) : opt(o), sFile(f) {}
+};
+
 
 //
 // --- function-prototypes -----------------------------------------------------
 //
-int parseCommandline(int argc, char *argv[]);
+int parseCommandline(int argc, char *argv[], ScaleOptions&);
 void PrintHelp(const std::string &s, const std::string &v);
-bool CheckUUIDs(void);
-void ProcessDirFile(pugi::xml_node);
-void ProcessElement(pugi::xml_node);
-std::string ToSVG(pugi::xml_node);
+bool CheckUUIDs(ElementJob&);
+int ProcessFile(const ScaleOptions&, const std::string&);
+void PrintLoadError(const std::string&, const pugi::xml_parse_result&);
+int ProcessDocument(ElementJob&, pugi::xml_document&);
+int PrepareDocument(ElementJob&, pugi::xml_document&);
+std::string OutputFileName(const ScaleOptions&, const std::string&, const bool, const bool);
+std::string OptionFingerprint(const ScaleOptions&);
+void TransformDocument(ElementJob&, pugi::xml_document&);
+void SerializeDocument(const ElementJob&, pugi::xml_document&, std::string&);
+int WriteOutput(const ElementJob&, const std::string&);
+int SaveDocument(const ElementJob&, pugi::xml_document&);
+int ProcessBatch(const ScaleOptions&);
+int ProcessBatchFile(const ScaleOptions&, const std::string&);
+int WatchBatch(const ScaleOptions&, DirWatcher&, ThreadPool&);
+size_t ProcessPipeline(const ScaleOptions&, const std::vector<std::string>&, const size_t);
+void ProcessDirFile(ElementJob&, pugi::xml_node);
+void ProcessElement(ElementJob&, pugi::xml_node);
+void ToSVG(const ElementJob&, pugi::xml_node, SvgWriter&);
+void PrimitivesToSVG(const ScaleOptions&, pugi::xml_node, SvgWriter&);
 
 // the possible Commandlineparameters:
 static const char cOptions[] = "f:hioF:x:y:X:Y:d:";
@@ -122,6 +183,17 @@ static struct option long_options[]={
     {"toSVG",no_argument,nullptr,1004},  // "long-opt" only!!!
     {"Rot90",no_argument,nullptr,1005},  // "long-opt" only!!!
     {"OnlyCleanMeta",no_argument,nullptr,1006},  // "long-opt" only!!!
+    {"recursive",required_argument,nullptr,1007},  // "long-opt" only!!!
+    {"jobs",required_argument,nullptr,1008},  // "long-opt" only!!!
+    {"pipeline",no_argument,nullptr,1009},  // "long-opt" only!!!
+    {"queue-depth",required_argument,nullptr,1010},  // "long-opt" only!!!
+    {"op",required_argument,nullptr,1011},  // "long-opt" only!!!
+    {"simd",no_argument,nullptr,1012},  // "long-opt" only!!!
+    {"svg-classes",no_argument,nullptr,1013},  // "long-opt" only!!!
+    {"svg-markers",no_argument,nullptr,1014},  // "long-opt" only!!!
+    {"uuid-mode",required_argument,nullptr,1015},  // "long-opt" only!!!
+    {"cache",no_argument,nullptr,1016},  // "long-opt" only!!!
+    {"watch",required_argument,nullptr,1017},  // "long-opt" only!!!
     {0,0,0,0}
   };
 
@@ -130,7 +202,78 @@ static struct option long_options[]={
 
 
 /******************************************************************************/
-int parseCommandline(int argc, char *argv[]) {
+// one "--op": "flipx", "flipy", "rotate=DEG", "scale=F", "scale=FX:FY"
+// or "move=DX:DY" -- ":" as separator, because "," may be a decimal-comma
+bool AddTransformOp(AffineTransform& t, const std::string& sOp) {
+    const size_t pos = sOp.find('=');
+    const std::string sName = sOp.substr(0, pos);
+    const std::string sArgs = (pos == std::string::npos) ? "" : sOp.substr(pos + 1);
+    // the numbers separated by ":"
+    std::vector<double> vVal;
+    if (pos != std::string::npos) {
+        std::stringstream ss(sArgs);
+        std::string sTmp;
+        while (std::getline(ss, sTmp, ':')) {
+            CheckForDoubleString(sTmp);
+            if (sTmp == "WontWork")
+                return false;
+            vVal.push_back(stod(sTmp));
+        }
+    }
+    if ((sName == "flipx") && (pos == std::string::npos)) {
+        t.FlipX();
+    } else if ((sName == "flipy") && (pos == std::string::npos)) {
+        t.FlipY();
+    } else if ((sName == "rotate") && (vVal.size() == 1)) {
+        t.Rotate(vVal[0]);
+    } else if ((sName == "scale") && ((vVal.size() == 1) || (vVal.size() == 2))) {
+        const double sx = vVal[0];
+        const double sy = vVal.back();
+        if ((sx < 0.01) || (sy < 0.01)) {
+            std::cerr << "scaling-factor negative or too small: " << sArgs << std::endl;
+            return false;
+        }
+        t.Scale(sx, sy);
+    } else if ((sName == "move") && (vVal.size() == 2)) {
+        t.Move(vVal[0], vVal[1]);
+    } else {
+        return false;
+    }
+    return true;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+// the old options first (in the old order), then all "--op" in the order of
+// the commandline: the elements are transformed only once with the result
+bool BuildTransform(ScaleOptions& opt) {
+    AffineTransform& t = opt.transform;
+    t = AffineTransform();
+    if (opt.xFlipHor)  t.FlipY();
+    if (opt.xFlipVert) t.FlipX();
+    if (opt.xRotate90) t.Rotate(90.0);
+    t.Scale(opt.scaleX, opt.scaleY);
+    if (opt.xMoveElement) t.Move(opt.moveX, opt.moveY);
+    for (const auto& sOp : opt.vsOps) {
+        if (AddTransformOp(t, sOp) == false) {
+            std::cerr << "could not convert \"" << sOp << "\" to valid operation!" << std::endl;
+            return false;
+        }
+    }
+    if (t.IsAxisAligned() == false) {
+        std::cerr << "rotation is not a multiple of 90 degree: rectangles, ellipses and arcs "
+                  << "stay parallel to the axes and are rotated around their center!\n";
+    }
+    return true;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int parseCommandline(int argc, char *argv[], ScaleOptions& opt) {
     int c;
     int option_index = 12345;
     std::string sTmp = "";
@@ -147,52 +290,164 @@ int parseCommandline(int argc, char *argv[]) {
                 if (std::string(long_options[option_index].name) == "RemoveAllTerminals"){
                     if (_DEBUG_)
                         std::cerr << "Remove all terminals from Element!\n";
-                    xRemoveAllTerminals = true;
+                    opt.xRemoveAllTerminals = true;
                 }
                 break;
             case 1001:
                 if (std::string(long_options[option_index].name) == "FlipHorizontal"){
                     if (_DEBUG_)
                         std::cerr << "Flip Element horizontally!\n";
-                    xFlipHor = true;
+                    opt.xFlipHor = true;
                 }
                 break;
             case 1002:
                 if (std::string(long_options[option_index].name) == "FlipVertical"){
                     if (_DEBUG_)
                         std::cerr << "Flip Element vertically!\n";
-                    xFlipVert = true;
+                    opt.xFlipVert = true;
                 }
                 break;
             case 1003:
                 if (std::string(long_options[option_index].name) == "OverwriteOriginal"){
                     if (_DEBUG_)
                         std::cerr << "Overwrite original file with scaled data!\n";
-                    xOverwriteOriginal = true;
+                    opt.xOverwriteOriginal = true;
                 }
                 break;
             case 1004:
                 if (std::string(long_options[option_index].name) == "toSVG"){
                     if (_DEBUG_)
                         std::cerr << "create SVG-data from Element-File\n";
-                    xCreateSVG  = true;
-                    xCreateELMT = false; // entoder-weder ... Beides gibt's nicht!
+                    opt.xCreateSVG  = true;
+                    opt.xCreateELMT = false; // entoder-weder ... Beides gibt's nicht!
                 }
                 break;
             case 1005:
                 if (std::string(long_options[option_index].name) == "Rot90"){
                     if (_DEBUG_)
                         std::cerr << "rotate element clockwise by 90 degree\n";
-                    xRotate90 = true;
+                    opt.xRotate90 = true;
                 }
                 break;
             case 1006:
                 if (std::string(long_options[option_index].name) == "OnlyCleanMeta"){
                     if (_DEBUG_)
                         std::cerr << "NO scaling or moving - sort names and delete empty information-nodes\n";
-                    xOnlyCleanMeta = true;
-                    xCreateSVG     = false; // SVG hat diese Daten nicht!
-                    xCreateELMT    = true;
+                    opt.xOnlyCleanMeta = true;
+                    opt.xCreateSVG     = false; // SVG hat diese Daten nicht!
+                    opt.xCreateELMT    = true;
+                }
+                break;
+            case 1007:
+                if (std::string(long_options[option_index].name) == "recursive"){
+                    if (_DEBUG_)
+                        std::cerr << "process all elements in directory \"" << optarg << "\"\n";
+                    opt.BatchDir = std::string(optarg);
+                    if (!std::filesystem::is_directory(opt.BatchDir)) {
+                        std::cerr << "\"" << optarg << "\" is not a directory!" << std::endl;
+                        opt.xStopWithError = true;
+                    }
+                }
+                break;
+            case 1008:
+                if (std::string(long_options[option_index].name) == "jobs"){
+                    sTmp = std::string(optarg);
+                    CheckForDoubleString(sTmp);
+                    if ((sTmp == "WontWork") || (stod(sTmp) < 1.0)) {
+                        std::cerr << "could not convert \"" << optarg << "\" to valid number of jobs!" << std::endl;
+                        opt.xStopWithError = true;
+                    } else {
+                        opt.iJobs = size_t(std::floor(stod(sTmp)));
+                        if (_DEBUG_)
+                            std::cerr << "use " << opt.iJobs << " worker-threads\n";
+                    }
+                }
+                break;
+            case 1009:
+                if (std::string(long_options[option_index].name) == "pipeline"){
+                    if (_DEBUG_)
+                        std::cerr << "process files in a pipeline\n";
+                    opt.xPipeline = true;
+                }
+                break;
+            case 1010:
+                if (std::string(long_options[option_index].name) == "queue-depth"){
+                    sTmp = std::string(optarg);
+                    CheckForDoubleString(sTmp);
+                    if ((sTmp == "WontWork") || (stod(sTmp) < 1.0)) {
+                        std::cerr << "could not convert \"" << optarg << "\" to valid queue-depth!" << std::endl;
+                        opt.xStopWithError = true;
+                    } else {
+                        opt.iQueueDepth = size_t(std::floor(stod(sTmp)));
+                        if (_DEBUG_)
+                            std::cerr << "use a queue-depth of " << opt.iQueueDepth << "\n";
+                    }
+                }
+                break;
+            case 1011:
+                if (std::string(long_options[option_index].name) == "op"){
+                    if (_DEBUG_)
+                        std::cerr << "additional operation: \"" << optarg << "\"\n";
+                    opt.vsOps.push_back(std::string(optarg));
+                }
+                break;
+            case 1012:
+                if (std::string(long_options[option_index].name) == "simd"){
+                    if (_DEBUG_)
+                        std::cerr << "transform points with " << SimdLevel() << "-kernels\n";
+                    opt.xSimd = true;
+                }
+                break;
+            case 1013:
+                if (std::string(long_options[option_index].name) == "svg-classes"){
+                    if (_DEBUG_)
+                        std::cerr << "create SVG-data with CSS-classes\n";
+                    opt.xSvgClasses = true;
+                    opt.xCreateSVG  = true;
+                    opt.xCreateELMT = false;
+                }
+                break;
+            case 1014:
+                if (std::string(long_options[option_index].name) == "svg-markers"){
+                    if (_DEBUG_)
+                        std::cerr << "create SVG-data with markers for the ends of lines\n";
+                    opt.xSvgMarkers = true;
+                    opt.xCreateSVG  = true;
+                    opt.xCreateELMT = false;
+                }
+                break;
+            case 1015:
+                if (std::string(long_options[option_index].name) == "uuid-mode"){
+                    sTmp = std::string(optarg);
+                    if (sTmp == "random") {
+                        opt.xUuidHash = false;
+                    } else if (sTmp == "hash") {
+                        opt.xUuidHash = true;
+                    } else {
+                        std::cerr << "unknown uuid-mode \"" << optarg << "\" (\"random\" or \"hash\")!" << std::endl;
+                        opt.xStopWithError = true;
+                    }
+                    if (_DEBUG_)
+                        std::cerr << "uuid-mode: " << (opt.xUuidHash ? "hash" : "random") << "\n";
+                }
+                break;
+            case 1016:
+                if (std::string(long_options[option_index].name) == "cache"){
+                    if (_DEBUG_)
+                        std::cerr << "skip unchanged files in batch-mode\n";
+                    opt.xCache = true;
+                }
+                break;
+            case 1017:
+                if (std::string(long_options[option_index].name) == "watch"){
+                    if (_DEBUG_)
+                        std::cerr << "watch directory \"" << optarg << "\"\n";
+                    opt.BatchDir = std::string(optarg);
+                    opt.xWatch = true;
+                    if (!std::filesystem::is_directory(opt.BatchDir)) {
+                        std::cerr << "\"" << optarg << "\" is not a directory!" << std::endl;
+                        opt.xStopWithError = true;
+                    }
                 }
                 break;
             case 'd':
@@ -200,124 +455,137 @@ int parseCommandline(int argc, char *argv[]) {
                 CheckForDoubleString(sTmp);
                 if ((sTmp == "WontWork") || (stod(std::string(sTmp)) < 0.0)) {
                     std::cerr << "could not convert \"" << optarg << "\" to valid number!" << std::endl;
-                    xStopWithError = true;
+                    opt.xStopWithError = true;
                 } else {
-                    decimals = size_t(std::floor(stod(std::string(optarg))));
+                    opt.decimals = size_t(std::floor(stod(std::string(optarg))));
                     if (_DEBUG_)
-                        std::cerr << "set number of decimals to " << decimals << "\n";
-                    MinLineLength = 1.5;
-                    for (uint8_t i=0; i < decimals; i++) { MinLineLength /= 10.0; }
+                        std::cerr << "set number of decimals to " << opt.decimals << "\n";
+                    opt.MinLineLength = 1.5;
+                    for (uint8_t i=0; i < opt.decimals; i++) { opt.MinLineLength /= 10.0; }
                 }
                 break;
             case 'i':
                 if (_DEBUG_)
                     std::cerr << "Read from STDIN\n";
-                xReadFromStdIn = true;
-                xPrintToStdOut = true;
+                opt.xReadFromStdIn = true;
+                opt.xPrintToStdOut = true;
                 break;
             case 'o':
                 if (_DEBUG_)
                     std::cerr << "Output to STDOUT\n";
-                xPrintToStdOut = true;
+                opt.xPrintToStdOut = true;
                 break;
             case 'h':
                 if (_DEBUG_)
                     std::cerr << "Help wanted...\n";
-                xPrintHelp = true;
+                opt.xPrintHelp = true;
                 break;
             case 'f':
                 if (_DEBUG_)
                     std::cerr << "use filename \"" << optarg << "\"\n";
-                ElementFile = std::string(optarg);
+                opt.ElementFile = std::string(optarg);
                 break;
             case 'F':
-                xScaleElement = true;
+                opt.xScaleElement = true;
                 sTmp = std::string(optarg);
                 CheckForDoubleString(sTmp);
                 if (sTmp == "WontWork"){
                     std::cerr << "could not convert \"" << optarg << "\" to float!" << std::endl;
-                    xStopWithError = true;
+                    opt.xStopWithError = true;
                 } else {
                     if (_DEBUG_) std::cerr << "Factor: " << sTmp << std::endl;
-                    scaleX = stod(sTmp);
-                    scaleY = scaleX;
-                    if (scaleX < 0.01) {
+                    opt.scaleX = stod(sTmp);
+                    opt.scaleY = opt.scaleX;
+                    if (opt.scaleX < 0.01) {
                         std::cerr << "scaling-factor negative or too small: " << sTmp << std::endl;
-                        xStopWithError = true;
+                        opt.xStopWithError = true;
                     }
                 }
                 break;
             case 'x':
-                xScaleElement = true;
+                opt.xScaleElement = true;
                 sTmp = std::string(optarg);
                 CheckForDoubleString(sTmp);
                 if (sTmp == "WontWork"){
                     std::cerr << "could not convert \"" << optarg << "\" to float!" << std::endl;
-                    xStopWithError = true;
+                    opt.xStopWithError = true;
                 } else {
                     if (_DEBUG_) std::cerr << "FactorX: " << sTmp << std::endl;
-                    scaleX = stod(sTmp);
-                    if (scaleX < 0.01) {
+                    opt.scaleX = stod(sTmp);
+                    if (opt.scaleX < 0.01) {
                         std::cerr << "scaling-factor negative or too small: " << sTmp << std::endl;
-                        xStopWithError = true;
+                        opt.xStopWithError = true;
                     }
                 }
                 break;
             case 'y':
-                xScaleElement = true;
+                opt.xScaleElement = true;
                 sTmp = std::string(optarg);
                 CheckForDoubleString(sTmp);
                 if (sTmp == "WontWork"){
                     std::cerr << "could not convert \"" << optarg << "\" to float!" << std::endl;
-                    xStopWithError = true;
+                    opt.xStopWithError = true;
                 } else {
                     if (_DEBUG_) std::cerr << "FactorY: " << sTmp << std::endl;
-                    scaleY = stod(sTmp);
-                    if (scaleY < 0.01) {
+                    opt.scaleY = stod(sTmp);
+                    if (opt.scaleY < 0.01) {
                         std::cerr << "scaling-factor negative or too small: " << sTmp << std::endl;
-                        xStopWithError = true;
+                        opt.xStopWithError = true;
                     }
                 }
                 break;
             case 'X':
-                xMoveElement = true;
+                opt.xMoveElement = true;
                 sTmp = std::string(optarg);
                 CheckForDoubleString(sTmp);
                 if (sTmp == "WontWork"){
                     std::cerr << "could not convert \"" << optarg << "\" to float!" << std::endl;
-                    xStopWithError = true;
+                    opt.xStopWithError = true;
                 } else {
                     if (_DEBUG_) std::cerr << "MoveX: " << sTmp << std::endl;
-                    moveX = stod(sTmp);
-                    if (std::abs(moveX) < 0.01) {
+                    opt.moveX = stod(sTmp);
+                    if (std::abs(opt.moveX) < 0.01) {
                         std::cerr << "delta-value too small: " << sTmp << std::endl;
-                        xStopWithError = true;
+                        opt.xStopWithError = true;
                     }
                 }
                 break;
             case 'Y':
-                xMoveElement = true;
+                opt.xMoveElement = true;
                 sTmp = std::string(optarg);
                 CheckForDoubleString(sTmp);
                 if (sTmp == "WontWork"){
                     std::cerr << "could not convert \"" << optarg << "\" to float!" << std::endl;
-                    xStopWithError = true;
+                    opt.xStopWithError = true;
                 } else {
                     if (_DEBUG_) std::cerr << "MoveY: " << sTmp << std::endl;
-                    moveY = stod(sTmp);
-                    if (std::abs(moveY) < 0.01) {
+                    opt.moveY = stod(sTmp);
+                    if (std::abs(opt.moveY) < 0.01) {
                         std::cerr << "delta-value too small: " << sTmp << std::endl;
-                        xStopWithError = true;
+                        opt.xStopWithError = true;
                     }
                 }
                 break;
             case '?':
                 std::cerr << " * * * there were non-handled option(s)!"<< std::endl;
-                xStopWithError = true;
+                opt.xStopWithError = true;
                 break;
         }
     }
 
+    // in batch-mode there is no single input or output:
+    if ((opt.BatchDir != "") && (opt.xReadFromStdIn || opt.xPrintToStdOut)) {
+        std::cerr << "\"--recursive\" cannot be combined with \"--stdin\" or \"--stdout\"!" << std::endl;
+        opt.xStopWithError = true;
+    }
+    if ((opt.BatchDir == "") && opt.xPipeline) {
+        std::cerr << "\"--pipeline\" can only be used with \"--recursive\"!" << std::endl;
+        opt.xStopWithError = true;
+    }
+    // all geometric operations in one matrix:
+    if ((opt.xStopWithError == false) && (BuildTransform(opt) == false))
+        opt.xStopWithError = true;
+
     if (_DEBUG_) std::cerr << "optind=" << optind << "; argc="<<argc << std::endl;
     // are there "non-option-Arguments"?
     int iDiff = argc - optind;
@@ -381,6 +649,34 @@ void PrintHelp(const std::string &s, const std::string &v){
     << "                         delete empty elementInformation                \n"
     << "  \"--OverwriteOriginal\"  the original file is replaced by scaled one  \n"
     << "                         (CAUTION: Be careful with this option!)        \n"
+    << "  \"--recursive DIR\"      process all \"*.elmt\"-files in DIR and all   \n"
+    << "                         sub-directories with worker-threads            \n"
+    << "  \"--jobs N\"             number of worker-threads for \"--recursive\"  \n"
+    << "                         (default: number of usable CPUs)               \n"
+    << "  \"--pipeline\"           \"--recursive\" with separate stages for read,  \n"
+    << "                         parse, transform, serialize and write; prints  \n"
+    << "                         the occupancy of the stages at the end         \n"
+    << "  \"--queue-depth N\"      max. number of files waiting between two      \n"
+    << "                         stages of \"--pipeline\" (default: 8)           \n"
+    << "  \"--op OP\"              additional operation after all other options; \n"
+    << "                         can be used several times (in this order):     \n"
+    << "                         \"flipx\", \"flipy\", \"rotate=DEG\",            \n"
+    << "                         \"scale=F\", \"scale=FX:FY\", \"move=DX:DY\"       \n"
+    << "  \"--simd\"               transform all points of lines and polygons in  \n"
+    << "                         one go with AVX2/SSE2 (useful for big elements)\n"
+    << "  \"--svg-classes\"        like \"--toSVG\", but the styles of the        \n"
+    << "                         primitives are CSS-classes in a \"<style>\"    \n"
+    << "  \"--svg-markers\"        like \"--toSVG\", but the ends of lines are    \n"
+    << "                         shared \"<marker>\"-definitions                \n"
+    << "  \"--uuid-mode=MODE\"     \"random\" (default): new UUIDs every run;      \n"
+    << "                         \"hash\": UUIDs from the old UUID of the element, \n"
+    << "                         the operations and the order of the nodes -    \n"
+    << "                         the same input gives the same output           \n"
+    << "  \"--cache\"              \"--recursive\" skips files, whose content and   \n"
+    << "                         options did not change since the last run      \n"
+    << "                         (\".QET_ElementScaler.cache\" in every directory)\n"
+    << "  \"--watch DIR\"          like \"--recursive DIR\", then keep on running  \n"
+    << "                         and process every changed element again        \n"
     << std::endl
     << "As always with free software: Use it at your own risk!                \n\n";
 }
@@ -390,29 +686,594 @@ void PrintHelp(const std::string &s, const std::string &v){
 
 
 /******************************************************************************/
-bool CheckUUIDs(void) {
-    uint64_t u64DynTextsOrg = lsUUIDsDynTexts.size();
-    lsUUIDsDynTexts.sort();
-    lsUUIDsDynTexts.unique();
-    xDynTextsUUIDsUnique = (lsUUIDsDynTexts.size() == u64DynTextsOrg);
-    if (xDynTextsUUIDsUnique == false) {
-        std::cerr << " * * UUIDs of dynamic_texts are not unique: Create new ones! * *\n";
+bool CheckUUIDs(ElementJob& job) {
+    // the duplicates were already found while reading the nodes
+    // batch-mode: which of the files?
+    const std::string sIn = (job.opt.BatchDir != "") ? (" in \"" + job.sFile + "\"") : "";
+    if (job.xDynTextsUUIDsUnique == false) {
+        std::cerr << " * * UUIDs of dynamic_texts" << sIn << " are not unique: Create new ones! * *\n";
     }
-    uint64_t u64TerminalsOrg = lsUUIDsTerminals.size();
-    lsUUIDsTerminals.sort();
-    lsUUIDsTerminals.unique();
-    xTerminalsUUIDsUnique = (lsUUIDsTerminals.size() == u64TerminalsOrg);
-    if (xTerminalsUUIDsUnique == false) {
-        std::cerr << " * * UUIDs of terminals are not unique: Create new ones! * *\n";
+    if (job.xTerminalsUUIDsUnique == false) {
+        std::cerr << " * * UUIDs of terminals" << sIn << " are not unique: Create new ones! * *\n";
     }
-    return (xDynTextsUUIDsUnique && xTerminalsUUIDsUnique);
+    return (job.xDynTextsUUIDsUnique && job.xTerminalsUUIDsUnique);
 }
 /******************************************************************************/
 
 
 
 /******************************************************************************/
-void ProcessDirFile(pugi::xml_node doc) {
+void PrintLoadError(const std::string& sFile, const pugi::xml_parse_result& result) {
+    // try to read the corrupt part and output to stderr
+    std::cerr << "File \"" << sFile << "\" could not be loaded: " << result.description() << std::endl;
+    std::cerr << "Check file up to byte-offset: " << result.offset << " -- content partly shown here:\n";
+    std::cerr << "(...)" << ReadPieceOfFile(sFile, result.offset, (get_terminal_width()-10)) << "(...)\n\n";
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int ProcessFile(const ScaleOptions& opt, const std::string& sFile) {
+    // map the XML-File into memory: the document points into this buffer
+    InputBuffer input;
+    if (!input.MapFile(sFile)) {
+        std::cerr << "File \"" << sFile << "\" could not be loaded: " << input.Error() << std::endl;
+        return -1;
+    }
+    // load Element from the buffer
+    pugi::xml_document doc;
+    pugi::xml_parse_result result = doc.load_buffer_inplace(input.Data(), input.ParseSize());
+    // check the result of "doc.load"-Function
+    if (!result){
+        PrintLoadError(sFile, result);
+        return -1;
+    } else {
+        if (_DEBUG_) std::cerr << "Element-Data loaded successfully.\n";
+    }
+    ElementJob job(opt, sFile);
+    return ProcessDocument(job, doc);
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int ProcessDocument(ElementJob& job, pugi::xml_document& doc) {
+    int iResult = PrepareDocument(job, doc);
+    if (iResult != 0)
+        return iResult;
+    TransformDocument(job, doc);
+    return SaveDocument(job, doc);
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int PrepareDocument(ElementJob& job, pugi::xml_document& doc) {
+    const ScaleOptions& opt   = job.opt;
+    const std::string&  sFile = job.sFile;
+    // these can change with the kind of data - per file:
+    job.xIsElmt   = false;
+    job.xIsDir    = false;
+    job.xToSVG    = opt.xCreateSVG;
+    job.xToELMT   = opt.xCreateELMT;
+
+    // xml-file was successfully loaded, let's check, what kind of data we have...
+    if (doc.child("definition").child("description")) {
+        job.xIsElmt = true;
+    } else if (doc.child("qet-directory").child("names")) {
+        job.xIsDir  = true;
+        job.xToSVG  = false; // cannot create SVG from directory-file
+        job.xToELMT = true;  // use the same xml-output-function for "element" and "qet_directory"
+    } else if (doc.child("titleblocktemplate")) {
+        std::cerr << "QElectroTech - titleblock-templates are not supported by QET_ElementScaler!\n";
+        return -2;
+    } else if (doc.child("project").child("diagram") && doc.child("project").child("collection")) {
+        std::cerr << "QElectroTech - project-files are not supported by QET_ElementScaler!\n";
+        return -2;
+    } else {
+        // no file-format we can handle here -> QUIT with message
+        std::cerr << "cannot handle \"" << sFile << "\": wrong file-content! " << std::endl;
+        return -2;
+    }
+
+    // build the filename for the output:
+    if ((opt.xPrintToStdOut == false) && (job.xToSVG == false) && (opt.xOverwriteOriginal == true))
+        std::cerr << "will overwrite original file!" << std::endl;
+    job.sOutFile = OutputFileName(opt, sFile, job.xIsElmt, job.xToSVG);
+    if (_DEBUG_) std::cerr << job.sOutFile << std::endl;
+    return 0;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+// empty for output to stdout
+std::string OutputFileName(const ScaleOptions& opt, const std::string& sFile,
+                           const bool xIsElmt, const bool xToSVG) {
+    std::string sOutFile = "";
+    if (opt.xPrintToStdOut == true) {
+        // no file
+    } else if (xToSVG == true) {
+        sOutFile = sFile + ".svg";
+    } else {
+        sOutFile = sFile;
+        if (opt.xOverwriteOriginal == true){
+            // the same file
+        } else if (xIsElmt == true) {
+            sOutFile.insert(sOutFile.length()-5, ".SCALED");
+        } else {
+            sOutFile += ".SCALED";
+        }
+    }
+    return sOutFile;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+// "--cache": all options, that change the output of an element
+std::string OptionFingerprint(const ScaleOptions& opt) {
+    std::string s = opt.transform.AsKey();
+    s += "d" + std::to_string(opt.decimals);
+    s += opt.xCreateSVG          ? "S" : "s";
+    s += opt.xCreateELMT         ? "E" : "e";
+    s += opt.xSvgClasses         ? "C" : "c";
+    s += opt.xSvgMarkers         ? "M" : "m";
+    s += opt.xRemoveAllTerminals ? "T" : "t";
+    s += opt.xOnlyCleanMeta      ? "O" : "o";
+    s += opt.xUuidHash           ? "H" : "h";
+    return s;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+void TransformDocument(ElementJob& job, pugi::xml_document& doc) {
+    // Process "qet_directory"
+    if (job.xIsDir) {
+        ProcessDirFile(job, doc);
+    }
+
+    // Process the Element-file: scale, flip, etc...
+    if (job.xIsElmt) {
+        ProcessElement(job, doc);
+    }
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+void SerializeDocument(const ElementJob& job, pugi::xml_document& doc, std::string& sData) {
+    if (job.xToSVG == true) {
+      // SVG-Daten erstellen
+      sData.clear();
+      SvgWriter w(sData);
+      ToSVG(job, doc, w);
+      w.Flush();
+      return;
+    }
+    if (job.xToELMT == false) {
+      sData.clear();
+      return;
+    }
+
+    // the XML as string: for the pipeline
+    QetXmlWriter writer(sData);
+    doc.save(writer, "    ", pugi::format_default | pugi::format_no_declaration);
+    writer.Flush();
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int SaveDocument(const ElementJob& job, pugi::xml_document& doc) {
+    if ((job.xToSVG == false) && (job.xToELMT == false))
+        return 0;
+
+    // write SVG or XML directly to the file or stdout - without a copy in memory
+    FILE* f = stdout;
+    if (job.opt.xPrintToStdOut == false) {
+        f = fopen(job.sOutFile.c_str(), "w");
+        if (f == nullptr) {
+            std::cerr << "saving \"" << job.sOutFile << "\" failed!\n";
+            return -1;
+        }
+    }
+    bool xOK = true;
+    if (job.xToSVG == true) {
+        SvgWriter w(f);
+        ToSVG(job, doc, w);
+        w << ((f == stdout) ? "\n\n" : "\n");
+        xOK = w.Flush();
+    } else {
+        QetXmlWriter writer(f);
+        doc.save(writer, "    ", pugi::format_default | pugi::format_no_declaration);
+        xOK = writer.Flush();
+    }
+    if (f != stdout)
+        xOK = (fclose(f) == 0) && xOK;
+    if (xOK == false) {
+        if (f == stdout)
+            std::cerr << "writing to stdout failed!\n";
+        else
+            std::cerr << "file \"" << job.sOutFile << "\" could not be saved!\n";
+        return -1;
+    }
+    if (_DEBUG_) std::cerr << "file \"" << job.sOutFile << "\" saved successfully!" << std::endl;
+    return 0;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int WriteOutput(const ElementJob& job, const std::string& sData) {
+    if (job.xToSVG == true) {
+      if (job.opt.xPrintToStdOut == true) {
+        // zur Standard-Ausgabe:
+        std::cout << sData << "\n\n";
+      } else {
+        // SVG speichern
+        std::ofstream out;
+        out.open(job.sOutFile, std::ios::out);
+        out << sData << "\n";
+        out.close();  // the rest is written here: check afterwards
+        if        ((out.rdstate() & std::ofstream::badbit) != 0) {
+            std::cerr << "file \"" << job.sOutFile << "\" could not be saved!\n";
+            return -1;
+        } else if ((out.rdstate() & std::ofstream::failbit) != 0) {
+            std::cerr << "saving \"" << job.sOutFile << "\" failed!\n";
+            return -1;
+        } else {
+            if (_DEBUG_) std::cerr << "file \"" << job.sOutFile << "\" saved successfully!" << std::endl;
+        }
+      }
+      return 0;
+    }
+
+    if (job.xToELMT == true) {
+        if (job.opt.xPrintToStdOut==true) {
+            if (_DEBUG_) std::cerr << "XML auf stdout ------------------------------------------------------" << std::endl;
+            std::cout << sData;
+            if (_DEBUG_) std::cerr << "XML auf stdout ------------------------------------------------------" << std::endl;
+        } else {
+            // save string to file:
+            std::ofstream outFile(job.sOutFile);
+            outFile << sData;
+            if        ((outFile.rdstate() & std::ofstream::badbit) != 0) {
+                std::cerr << "file \"" << job.sOutFile << "\" could not be saved!\n";
+                return -1;
+            } else if ((outFile.rdstate() & std::ofstream::failbit) != 0) {
+                std::cerr << "saving \"" << job.sOutFile << "\" failed!\n";
+                return -1;
+            } else {
+                if (_DEBUG_) std::cerr << "file \"" << job.sOutFile << "\" saved successfully!" << std::endl;
+            }
+            outFile.close();
+        }
+    }
+    return 0;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+int ProcessBatch(const ScaleOptions& optIn) {
+    // "--watch": started before the first run - no change gets lost
+    std::unique_ptr<DirWatcher> pWatcher;
+    if (optIn.xWatch && optIn.xOverwriteOriginal) {
+        std::cerr << "\"--watch\" with \"--OverwriteOriginal\" would process its own output again!\n";
+        return -1;
+    } else if (optIn.xWatch) {
+        pWatcher = std::make_unique<DirWatcher>(optIn.BatchDir);
+        if (!pWatcher->IsOK()) {
+            std::cerr << "\"" << optIn.BatchDir << "\" can not be watched: " << pWatcher->Error() << "\n";
+            return -1;
+        }
+    }
+    std::vector<std::string> vsFiles = FindElementFiles(optIn.BatchDir);
+    // the element-UUIDs of all files: for duplicates across the files
+    UUIDIndex uuidIndex(vsFiles.size());
+    ScaleOptions opt = optIn;
+    opt.pUuidIndex = &uuidIndex;
+    size_t nJobs = opt.iJobs;
+    if (nJobs == 0)
+        nJobs = GetDefaultJobCount();
+    // "--watch": the files to come need the threads as well
+    if (opt.xWatch == false)
+        nJobs = std::min(nJobs, vsFiles.size());
+    nJobs = std::max((size_t)1, nJobs);
+    // one pool for all steps - and for "--watch" afterwards
+    ThreadPool pool(nJobs);
+    // "--cache": unchanged files are not processed again
+    const size_t nFound = vsFiles.size();
+    std::unique_ptr<BatchCache> pCache;
+    if (opt.xCache && opt.xOverwriteOriginal) {
+        std::cerr << "\"--cache\" is ignored with \"--OverwriteOriginal\": every run changes the input!\n";
+    } else if (opt.xCache) {
+        pCache = std::make_unique<BatchCache>(OptionFingerprint(opt), sVersion);
+        opt.pCache = pCache.get();
+    }
+    // the element-UUIDs of all inputs before the first file is processed: of
+    // copies of an element the first file in sorted order keeps the UUID and
+    // the others get new ones - independent of the order of the threads;
+    // the UUIDs of unchanged files come from the cache
+    std::vector<char> vxSkip(vsFiles.size(), 0);
+    {
+        std::vector<std::string> vsUuids(vsFiles.size());
+        for (size_t i = 0; i < vsFiles.size(); i++) {
+            pool.Submit([&opt, &vsFiles, &vsUuids, &vxSkip, i]() {
+                if (opt.pCache != nullptr) {
+                    const std::string sOut = OutputFileName(opt, vsFiles[i], true, opt.xCreateSVG);
+                    vxSkip[i] = opt.pCache->IsUpToDate(vsFiles[i], sOut, vsUuids[i]);
+                } else {
+                    vsUuids[i] = ReadElementUUID(vsFiles[i]);
+                }
+            });
+        }
+        pool.Wait();
+        std::string sOther;
+        for (size_t i = 0; i < vsFiles.size(); i++)
+            if (!vsUuids[i].empty()) uuidIndex.Insert(vsUuids[i], vsFiles[i], sOther);
+    }
+    if (opt.pCache != nullptr) {
+        size_t n = 0;
+        for (size_t i = 0; i < vsFiles.size(); i++)
+            if (vxSkip[i] == 0) {
+                if (n != i) vsFiles[n] = std::move(vsFiles[i]);
+                n++;
+            }
+        vsFiles.resize(n);
+    }
+    // large elements first: they should not be the last ones in the run
+    SortLargestFirst(vsFiles);
+    if (_DEBUG_) std::cerr << vsFiles.size() << " files with " << nJobs << " jobs\n";
+    std::atomic<size_t> nFailed{0};
+    if (opt.xPipeline) {
+        nFailed = ProcessPipeline(opt, vsFiles, nJobs);
+    } else {
+        // every worker does the complete work for one file: load, process,
+        // save - so the document can live in the arena of the worker
+        InstallArenaAllocator();
+        for (const std::string& sFile : vsFiles) {
+            pool.Submit([&opt, &nFailed, sFile]() {
+                if (ProcessBatchFile(opt, sFile) != 0) nFailed++;
+            });
+        }
+        pool.Wait();
+        if (_DEBUG_) std::cerr << "arena: high-water-mark " << (GetArenaHighWaterMark() / 1024) << " KiB\n";
+    }
+    if ((pCache != nullptr) && (pCache->Save() == false))
+        nFailed++;
+    std::cerr << "processed " << vsFiles.size() << " files";
+    if (nFailed > 0) std::cerr << " (" << nFailed << " failed)";
+    if (nFound > vsFiles.size()) std::cerr << ", " << (nFound - vsFiles.size()) << " unchanged";
+    if (GetArenaHighWaterMark() > 0) std::cerr << ", max. " << ((GetArenaHighWaterMark() + 1023) / 1024) << " KiB per file";
+    std::cerr << "\n";
+    if (pWatcher != nullptr)
+        return WatchBatch(opt, *pWatcher, pool);
+    return ((nFailed > 0) ? -1 : 0);
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+// the work of a worker-thread for one file: load, process, save - so the
+// document can live in the arena of the worker
+int ProcessBatchFile(const ScaleOptions& opt, const std::string& sFile) {
+    int iResult = -1;
+    ArenaScope arena;  // reset after "ProcessFile" -> the document is gone then
+    try {
+        iResult = ProcessFile(opt, sFile);
+    } catch (const std::exception& e) {
+        std::cerr << "\"" << sFile << "\": " << e.what() << "\n";
+    }
+    if ((iResult == 0) && (opt.pCache != nullptr))
+        opt.pCache->Done(sFile);
+    return iResult;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+// "--watch": the process stays alive with its worker-threads, arenas and
+// the UUIDs of all files and processes only the changed files again
+int WatchBatch(const ScaleOptions& opt, DirWatcher& watcher, ThreadPool& pool) {
+    using Clock = std::chrono::steady_clock;
+    const int msQuiet = 150;  // a burst of saves is processed once
+    InstallArenaAllocator();
+    std::cerr << "watching \"" << opt.BatchDir << "\" for changes ...\n";
+    while (watcher.IsOK()) {
+        std::vector<std::string> vsFiles = watcher.Wait(msQuiet);
+        if (vsFiles.empty())
+            continue;
+        const auto t0 = Clock::now();
+        std::atomic<size_t> nFailed{0};
+        std::atomic<size_t> nDone{0};
+        for (const std::string& sFile : vsFiles) {
+            pool.Submit([&opt, &nFailed, &nDone, sFile]() {
+                // e.g. saved without changes:
+                std::string sUuid;
+                if ((opt.pCache != nullptr) &&
+                    opt.pCache->IsUpToDate(sFile, OutputFileName(opt, sFile, true, opt.xCreateSVG), sUuid))
+                    return;
+                if (ProcessBatchFile(opt, sFile) != 0) nFailed++;
+                nDone++;
+            });
+        }
+        pool.Wait();
+        if ((opt.pCache != nullptr) && (opt.pCache->Save() == false))
+            nFailed++;
+        const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - t0).count();
+        std::cerr << "processed " << nDone << " changed files";
+        if (nFailed > 0) std::cerr << " (" << nFailed << " failed)";
+        if (vsFiles.size() > nDone) std::cerr << ", " << (vsFiles.size() - nDone) << " unchanged";
+        std::cerr << " in " << ms << " ms\n";
+    }
+    std::cerr << "watching \"" << opt.BatchDir << "\" stopped: " << watcher.Error() << "\n";
+    return -1;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+// a file on its way through the pipeline
+struct PipelineItem
+{
+    ElementJob job;
+    InputBuffer input;        // the file-content: has to live longer than "doc"
+    pugi::xml_document doc;
+    std::string sData = "";   // the output
+    PipelineItem(const ScaleOptions& o, const std::string& f) : job(o, f) {}
+};
+// ---
+// threads, processed files and busy-time of a stage of the pipeline
+struct PipelineStage
+{
+    const char* name;
+    size_t threads;
+    std::atomic<size_t>   running{0};
+    std::atomic<uint64_t> items{0};
+    std::atomic<uint64_t> busyNs{0};
+    PipelineStage(const char* n, size_t t) : name(n), threads(t) {}
+};
+// ---
+size_t ProcessPipeline(const ScaleOptions& opt, const std::vector<std::string>& vsFiles, const size_t nJobs) {
+    using ItemPtr = std::unique_ptr<PipelineItem>;
+    using Queue   = BoundedQueue<ItemPtr>;
+    using Clock   = std::chrono::steady_clock;
+    std::atomic<size_t> nFailed{0};
+
+    // reading and writing are done by one thread each, the "--jobs"
+    // are shared by the cpu-bound stages - the most for "transform":
+    size_t nParse     = std::max((size_t)1, nJobs / 4);
+    size_t nSerialize = std::max((size_t)1, nJobs / 4);
+    size_t nTransform = std::max((size_t)1, nJobs - std::min(nJobs, nParse + nSerialize));
+    PipelineStage stRead("read", 1), stParse("parse", nParse), stTransform("transform", nTransform),
+                  stSerialize("serialize", nSerialize), stWrite("write", 1);
+
+    // the input of the first stage: all files - the other queues are bounded
+    Queue qFiles(vsFiles.size());
+    for (const std::string& sFile : vsFiles)
+        qFiles.Push(std::make_unique<PipelineItem>(opt, sFile));
+    qFiles.Close();
+    Queue qRead(opt.iQueueDepth), qParse(opt.iQueueDepth),
+          qTransform(opt.iQueueDepth), qSerialize(opt.iQueueDepth);
+
+    // every thread of a stage takes a file from "in", does its work and
+    // passes the file to "out"; the last thread of a stage closes "out"
+    std::vector<std::thread> threads;
+    auto StartStage = [&](PipelineStage& stage, Queue& in, Queue* out,
+                          std::function<bool(PipelineItem&)> work) {
+        stage.running = stage.threads;
+        for (size_t i = 0; i < stage.threads; i++) {
+            threads.emplace_back([&stage, &in, out, work, &nFailed]() {
+                ItemPtr item;
+                while (in.Pop(item)) {
+                    auto t0 = Clock::now();
+                    bool xOK = false;
+                    try {
+                        xOK = work(*item);
+                    } catch (const std::exception& e) {
+                        std::cerr << "\"" << item->job.sFile << "\": " << e.what() << "\n";
+                    }
+                    stage.busyNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+                    stage.items++;
+                    if (!xOK)
+                        nFailed++;
+                    else if (out != nullptr)
+                        out->Push(std::move(item));
+                    item.reset();
+                }
+                if ((--stage.running == 0) && (out != nullptr))
+                    out->Close();
+            });
+        }
+    };
+
+    auto tStart = Clock::now();
+    StartStage(stRead, qFiles, &qRead, [](PipelineItem& it) {
+        if (!it.input.MapFile(it.job.sFile)) {
+            std::cerr << "File \"" << it.job.sFile << "\" could not be loaded: " << it.input.Error() << "\n";
+            return false;
+        }
+        it.input.Prefetch();  // the disk-access belongs to this stage
+        return true;
+    });
+    StartStage(stParse, qRead, &qParse, [](PipelineItem& it) {
+        pugi::xml_parse_result result = it.doc.load_buffer_inplace(it.input.Data(), it.input.ParseSize());
+        if (!result) {
+            PrintLoadError(it.job.sFile, result);
+            return false;
+        }
+        return true;
+    });
+    StartStage(stTransform, qParse, &qTransform, [](PipelineItem& it) {
+        if (PrepareDocument(it.job, it.doc) != 0)
+            return false;
+        TransformDocument(it.job, it.doc);
+        return true;
+    });
+    StartStage(stSerialize, qTransform, &qSerialize, [](PipelineItem& it) {
+        SerializeDocument(it.job, it.doc, it.sData);
+        it.doc.reset();  // the document and ...
+        it.input.Release();  // ... its data are not needed anymore
+        return true;
+    });
+    StartStage(stWrite, qSerialize, nullptr, [](PipelineItem& it) {
+        if (WriteOutput(it.job, it.sData) != 0)
+            return false;
+        if (it.job.opt.pCache != nullptr)
+            it.job.opt.pCache->Done(it.job.sFile);
+        return true;
+    });
+    for (auto& t : threads)
+        t.join();
+    double dWallNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tStart).count();
+
+    // occupancy of the stages and fill-level of the queues: the bottleneck
+    // is the stage with the highest occupancy - the queue in front of it is
+    // often full and the queues behind it are often empty
+    std::cerr << "pipeline: " << vsFiles.size() << " files in " << std::fixed << std::setprecision(3)
+              << (dWallNs / 1e9) << " s, queue-depth " << opt.iQueueDepth << "\n";
+    std::cerr << "  stage       threads  files  occupancy\n";
+    for (const PipelineStage* st : {&stRead, &stParse, &stTransform, &stSerialize, &stWrite}) {
+        double dOccupancy = (dWallNs > 0.0) ? (100.0 * (double)st->busyNs / (dWallNs * (double)st->threads)) : 0.0;
+        std::cerr << "  " << std::left << std::setw(10) << st->name << std::right
+                  << std::setw(9) << st->threads << std::setw(7) << st->items
+                  << std::setw(10) << std::setprecision(1) << dOccupancy << " %\n";
+    }
+    std::cerr << "  queue                  avg. fill  push waited  pop waited\n";
+    const std::pair<const char*, const Queue*> queues[] = {
+        {"read -> parse", &qRead}, {"parse -> transform", &qParse},
+        {"transform -> serialize", &qTransform}, {"serialize -> write", &qSerialize}};
+    for (const auto& q : queues) {
+        std::cerr << "  " << std::left << std::setw(22) << q.first << std::right
+                  << std::setw(11) << std::setprecision(1) << q.second->AverageFill()
+                  << std::setw(13) << q.second->WaitFull() << std::setw(12) << q.second->WaitEmpty() << "\n";
+    }
+    std::cerr << std::defaultfloat;
+    return nFailed;
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+void ProcessDirFile(ElementJob& job, pugi::xml_node doc) {
+    (void)job; // nothing to scale in a "qet_directory"
     NamesList Namen;
     Namen.ReadFromPugiNode(doc.child("qet-directory").child("names"));
     Namen.WriteToPugiNode(doc.child("qet-directory").child("names"));
@@ -423,23 +1284,100 @@ void ProcessDirFile(pugi::xml_node doc) {
 
 
 /******************************************************************************/
-void ProcessElement(pugi::xml_node doc) {
+// "--simd": lines and polygons of an element are read in advance and all their
+// points are transformed together in ONE buffer; the main-loop of
+// "ProcessElement" then takes the objects in the same order
+struct SimdPrePass
+{
+    CoordBuffer coords;
+    std::vector<ElmtLine>    lines;
+    std::vector<ElmtPolygon> polys;
+    std::vector<size_t>      lineOffsets;
+    std::vector<size_t>      polyOffsets;
+    size_t iLine = 0;
+    size_t iPoly = 0;
+};
+// ---
+void GatherLinesAndPolygons(SimdPrePass& simd, pugi::xml_node node, const AffineTransform& t) {
+    for (; node; node = node.next_sibling()) {
+        switch (LookupNodeKind(node.name())) {
+        case NodeKind::line:
+            simd.lines.emplace_back();
+            if (simd.lines.back().ReadFromPugiNode(node) == true) {
+                simd.lineOffsets.push_back(simd.lines.back().GatherPoints(simd.coords));
+            } else {
+                // Invalid line will be ignored and deleted later!
+                simd.lines.pop_back();
+                node.set_name("LINE_NodeToDelete");
+            }
+            break;
+        case NodeKind::polygon:
+            simd.polys.emplace_back();
+            if (simd.polys.back().ReadFromPugiNode(node) == true) {
+                simd.polyOffsets.push_back(simd.polys.back().GatherPoints(simd.coords));
+            } else {
+                // Invalid polygon will be ignored and deleted later!
+                simd.polys.pop_back();
+                node.set_name("POLYGON_NodeToDelete");
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    // all points in one go:
+    t.ApplyToPoints(simd.coords);
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+void ProcessElement(ElementJob& job, pugi::xml_node doc) {
+    const ScaleOptions& opt = job.opt;
     RectMinMax ElmtMinMax; // for Re-Calc of DefinitionLine!
 
+    // "--uuid-mode=hash": all new UUIDs of this element from its old UUID (or
+    // the file-name), the transformation and the number of decimals
+    std::string sUuidKey;
+    if (opt.xUuidHash) {
+        const char* pOldUuid = doc.child("definition").child("uuid").attribute("uuid").value();
+        sUuidKey  = (pOldUuid[0] != '\0') ? std::string(pOldUuid) : job.sFile;
+        sUuidKey += "|" + opt.transform.AsKey() + "|" + std::to_string(opt.decimals);
+    }
+    UUIDHashScope uuidScope(opt.xUuidHash, sUuidKey);
+
+    // batch-mode: the element-UUID of the input must not be used by another
+    // file (e.g. a copied and modified element) - the owner was determined
+    // before the run (see "ProcessBatch"), all other files get a new one
+    bool xDuplicate = false;
+    pugi::xml_attribute attrUuid = doc.child("definition").child("uuid").attribute("uuid");
+    if ((opt.pUuidIndex != nullptr) && attrUuid) {
+        std::string sOther;
+        if (opt.pUuidIndex->Insert(attrUuid.value(), job.sFile, sOther) == false) {
+            std::cerr << " * * element-UUID of \"" << job.sFile << "\" is also used by \""
+                      << sOther << "\": Create a new one! * *\n";
+            xDuplicate = true;
+        }
+    }
     // create or renew element's uuid:
     if (!(doc.child("definition").child("uuid"))) {
         if (_DEBUG_) std::cerr << "Erstelle Element-UUID!\n" ;
         doc.child("definition").prepend_child("uuid");
-        doc.child("definition").child("uuid").append_attribute("uuid").set_value(("{" + CreateUUID(false) + "}"));
+        doc.child("definition").child("uuid").append_attribute("uuid").set_value(CreateBracedUUID().c_str());
+    } else if (xDuplicate) {
+        // "--uuid-mode=hash": the copies have the same old UUID - the file-name makes the new ones different
+        UUIDHashScope renewScope(opt.xUuidHash, sUuidKey + "|" + job.sFile);
+        attrUuid.set_value(CreateBracedUUID().c_str());
     } else {
-        if (xOnlyCleanMeta == false) {
+        if (opt.xOnlyCleanMeta == false) {
             // wenn bei bestehenden Elementen nur die Texte sortiert werden, keine neue UUID: "Es ändert sich ja nix!"
             if (_DEBUG_) std::cerr << "Aktualisiere vorhandene Element-UUID!\n" ;
-            doc.child("definition").child("uuid").attribute("uuid").set_value(("{" + CreateUUID(false) + "}"));
+            attrUuid.set_value(CreateBracedUUID().c_str());
         }
     }
     // wenn die Anschlüsse alle weg sollen...
-    if (xRemoveAllTerminals==true) {
+    if (opt.xRemoveAllTerminals==true) {
         if (_DEBUG_) std::cerr << "change \"link_type\" to \"thumbnail\"" << std::endl;
         doc.child("definition").attribute("link_type").set_value("thumbnail");
         while(doc.child("definition").child("description").remove_child("terminal"));
@@ -463,122 +1401,119 @@ void ProcessElement(pugi::xml_node doc) {
     AInfo.UpdatePugiNode(doc.child("definition").child("informations"));
     // in einer Schleife die Elemente bearbeiten - wir starten hier:
     pugi::xml_node node = doc.child("definition").child("description").first_child();
+    // "--simd": first all lines and polygons
+    SimdPrePass simd;
+    if ((opt.xOnlyCleanMeta == false) && opt.xSimd)
+        GatherLinesAndPolygons(simd, node, opt.transform);
     // ... in a loop all parts
-    if (xOnlyCleanMeta == false)
+    if (opt.xOnlyCleanMeta == false)
         for (; node; node = node.next_sibling()) {
-        if ((std::string(node.name())) == "rect") {
+        switch (LookupNodeKind(node.name())) {
+        case NodeKind::rect: {
             ElmtRect rect;
             rect.Clear();
             rect.ReadFromPugiNode(node);
-            if (xFlipHor)  rect.Flip();
-            if (xFlipVert) rect.Mirror();
-            if (xRotate90) rect.Rot90();
-            rect.Scale(scaleX, scaleY);
-            if (xMoveElement) rect.Move(moveX, moveY);
-            rect.WriteToPugiNode(node, decimals);
+            rect.Transform(opt.transform);
+            rect.WriteToPugiNode(node, opt.decimals);
             ElmtMinMax.addx(rect.GetX());
             ElmtMinMax.addx(rect.GetX()+rect.GetWidth());
             ElmtMinMax.addy(rect.GetY());
             ElmtMinMax.addy(rect.GetY()+rect.GetHeight());
+            break;
         }
-        if ((std::string(node.name())) == "arc") {
+        case NodeKind::arc: {
             ElmtArc arc;
             arc.Clear();
             arc.ReadFromPugiNode(node);
-            if (xFlipHor)  arc.Flip();
-            if (xFlipVert) arc.Mirror();
-            if (xRotate90) arc.Rot90();
-            arc.Scale(scaleX, scaleY);
-            if (xMoveElement) arc.Move(moveX, moveY);
-            arc.Normalize();
-            arc.WriteToPugiNode(node, decimals);
+            arc.Transform(opt.transform);
+            arc.WriteToPugiNode(node, opt.decimals);
             ElmtMinMax.addx(arc.GetMinX());
             ElmtMinMax.addx(arc.GetMaxX());
             ElmtMinMax.addy(arc.GetMinY());
             ElmtMinMax.addy(arc.GetMaxY());
+            break;
         }
-        if (((std::string(node.name())) == "ellipse") || ((std::string(node.name())) == "circle")) {
+        case NodeKind::ellipse:
+        case NodeKind::circle: {
             ElmtEllipse elli;
             elli.Clear();
             elli.ReadFromPugiNode(node);
-            if (xFlipHor)  elli.Flip();
-            if (xFlipVert) elli.Mirror();
-            if (xRotate90) elli.Rot90();
-            elli.Scale(scaleX, scaleY);
-            if (xMoveElement) elli.Move(moveX, moveY);
-            elli.WriteToPugiNode(node, decimals);
+            elli.Transform(opt.transform);
+            elli.WriteToPugiNode(node, opt.decimals);
             ElmtMinMax.addx(elli.GetX());
             ElmtMinMax.addx(elli.GetX()+elli.GetWidth());
             ElmtMinMax.addy(elli.GetY());
             ElmtMinMax.addy(elli.GetY()+elli.GetHeight());
             node.set_name("ellipse");
+            break;
         }
-        if ((std::string(node.name())) == "text") {
+        case NodeKind::text: {
             ElmtText text;
             text.ReadFromPugiNode(node);
-            if (xFlipHor)  text.Flip();
-            if (xFlipVert) text.Mirror();
-            if (xRotate90) text.Rot90();
-            text.Scale(scaleX, scaleY);
-            if (xMoveElement) text.Move(moveX, moveY);
-            text.WriteToPugiNode(node, decimals);
+            text.Transform(opt.transform);
+            text.WriteToPugiNode(node, opt.decimals);
             if (!((text.GetText() == "") || (text.GetText() == "_"))) {
                 ElmtMinMax.addx(text.GetX()-text.GetSize());
                 ElmtMinMax.addx(text.GetX()+text.GetSize());
                 ElmtMinMax.addy(text.GetY()-text.GetSize());
                 ElmtMinMax.addy(text.GetY()+text.GetSize());
             }
+            break;
         }
-        if ((std::string(node.name())) == "terminal") {
+        case NodeKind::terminal: {
             ElmtTerminal term;
             term.ReadFromPugiNode(node);
-            if (xFlipHor)  term.Flip();
-            if (xFlipVert) term.Mirror();
-            if (xRotate90) term.Rot90();
-            term.Scale(scaleX, scaleY);
-            if (xMoveElement) term.Move(moveX, moveY);
+            term.Transform(opt.transform);
             if (node.attribute("uuid")) {
-                lsUUIDsTerminals.push_back(node.attribute("uuid").as_string());
+                if (job.setUUIDsTerminals.Insert(UUIDKey(node.attribute("uuid").as_string())) == false)
+                    job.xTerminalsUUIDsUnique = false;
             }
             term.WriteToPugiNode(node);
             ElmtMinMax.addx(term.GetX()-5);
             ElmtMinMax.addx(term.GetX()+5);
             ElmtMinMax.addy(term.GetY()+5);
             ElmtMinMax.addy(term.GetY()-5);
+            break;
         }
-        if ((std::string(node.name())) == "input") {
+        case NodeKind::input: {
             ElmtInput input;
             input.ConvertToDynText(node);
+            // now it is a "dynamic_text":
+            [[fallthrough]];
         }
-        if ((std::string(node.name())) == "dynamic_text") {
+        case NodeKind::dynamic_text: {
             ElmtDynText dyntext;
             dyntext.ReadFromPugiNode(node);
-            if (xFlipHor)  dyntext.Flip();
-            if (xFlipVert) dyntext.Mirror();
-            if (xRotate90) dyntext.Rot90();
-            dyntext.Scale(scaleX, scaleY);
-            if (xMoveElement) dyntext.Move(moveX, moveY);
+            dyntext.Transform(opt.transform);
             if (node.attribute("uuid")) {
-                lsUUIDsDynTexts.push_back(node.attribute("uuid").as_string());
+                if (job.setUUIDsDynTexts.Insert(UUIDKey(node.attribute("uuid").as_string())) == false)
+                    job.xDynTextsUUIDsUnique = false;
             }
-            dyntext.WriteToPugiNode(node, decimals);
+            dyntext.WriteToPugiNode(node, opt.decimals);
             if (!((dyntext.GetText() == "") || (dyntext.GetText() == "_"))) {
                 ElmtMinMax.addx(dyntext.GetX()-dyntext.GetSize());
                 ElmtMinMax.addx(dyntext.GetX()+dyntext.GetSize());
                 ElmtMinMax.addy(dyntext.GetY()-dyntext.GetSize());
                 ElmtMinMax.addy(dyntext.GetY()+dyntext.GetSize());
             }
+            break;
         }
-        if ((std::string(node.name())) == "line") {
+        case NodeKind::line: {
             ElmtLine line;
-            if (line.ReadFromPugiNode(node) == true) {
-                if (xFlipHor)  line.Flip();
-                if (xFlipVert) line.Mirror();
-                if (xRotate90) line.Rot90();
-                line.Scale(scaleX, scaleY);
-                if (xMoveElement) line.Move(moveX, moveY);
-                line.CleanUp(node, MinLineLength);
-                line.WriteToPugiNode(node, decimals);
+            bool xValid = true;
+            if (opt.xSimd) {
+                // read and transformed in "GatherLinesAndPolygons":
+                line = std::move(simd.lines[simd.iLine]);
+                line.ScatterPoints(simd.coords, simd.lineOffsets[simd.iLine++]);
+                line.TransformLengths(opt.transform);
+            } else if (line.ReadFromPugiNode(node) == true) {
+                line.Transform(opt.transform);
+            } else {
+                xValid = false;
+            }
+            if (xValid) {
+                line.CleanUp(node, opt.MinLineLength);
+                line.WriteToPugiNode(node, opt.decimals);
                 if (line.CheckIndex(node.name()) == true) {
                     ElmtMinMax.addx(line.GetMinX());
                     ElmtMinMax.addx(line.GetMaxX());
@@ -589,17 +1524,23 @@ void ProcessElement(pugi::xml_node doc) {
                 // Invalid line will be ignored and deleted later!
                 node.set_name("LINE_NodeToDelete");
             }
+            break;
         }
-        if ((std::string(node.name())) == "polygon") {
+        case NodeKind::polygon: {
             ElmtPolygon poly;
-            if (poly.ReadFromPugiNode(node) == true) {
-                if (xFlipHor)  poly.Flip();
-                if (xFlipVert) poly.Mirror();
-                if (xRotate90) poly.Rot90();
-                poly.Scale(scaleX, scaleY);
-                if (xMoveElement) poly.Move(moveX, moveY);
-                poly.CleanUp(node, MinLineLength);
-                poly.WriteToPugiNode(node, decimals);
+            bool xValid = true;
+            if (opt.xSimd) {
+                // read and transformed in "GatherLinesAndPolygons":
+                poly = std::move(simd.polys[simd.iPoly]);
+                poly.ScatterPoints(simd.coords, simd.polyOffsets[simd.iPoly++]);
+            } else if (poly.ReadFromPugiNode(node) == true) {
+                poly.Transform(opt.transform);
+            } else {
+                xValid = false;
+            }
+            if (xValid) {
+                poly.CleanUp(node, opt.MinLineLength);
+                poly.WriteToPugiNode(node, opt.decimals);
                 if (poly.CheckIndex(node.name()) == true) {
                     ElmtMinMax.addx(poly.GetMinX());
                     ElmtMinMax.addx(poly.GetMaxX());
@@ -610,32 +1551,35 @@ void ProcessElement(pugi::xml_node doc) {
                 // Invalid polygon will be ignored and deleted later!
                 node.set_name("POLYGON_NodeToDelete");
             }
+            break;
+        }
+        case NodeKind::other:
+            break;
         }
     }
     // Cleanup the QET-Element by removing invalid parts:
     while(doc.child("definition").child("description").remove_child("LINE_NodeToDelete"));
     while(doc.child("definition").child("description").remove_child("POLYGON_NodeToDelete"));
     // die UUIDs prüfen, ob sie denn wirklich "unique" sind:
-    if (CheckUUIDs() == false) {
+    if (CheckUUIDs(job) == false) {
         // in einer Schleife die UUIDs der Elemente bearbeiten:
         node = doc.child("definition").child("description").first_child();
         for (; node; node = node.next_sibling())
         {
-            if (((std::string(node.name())) == "terminal") && (xTerminalsUUIDsUnique == false)) {
-                std::string uuid = "{" + CreateUUID(false) + "}";
-                node.attribute("uuid").set_value(uuid);
+            const NodeKind kind = LookupNodeKind(node.name());
+            if ((kind == NodeKind::terminal) && (job.xTerminalsUUIDsUnique == false)) {
+                node.attribute("uuid").set_value(CreateBracedUUID().c_str());
             }
-            if (((std::string(node.name())) == "dynamic_text") && (xDynTextsUUIDsUnique == false)) {
-                std::string uuid = "{" + CreateUUID(false) + "}";
-                node.attribute("uuid").set_value(uuid);
+            if ((kind == NodeKind::dynamic_text) && (job.xDynTextsUUIDsUnique == false)) {
+                node.attribute("uuid").set_value(CreateBracedUUID().c_str());
             }
         }
     }
     // die Listen der UUIDs werden nicht mehr benötigt: leeren!
-    lsUUIDsDynTexts.clear();
-    lsUUIDsTerminals.clear();
+    job.setUUIDsDynTexts.Clear();
+    job.setUUIDsTerminals.Clear();
     // die definitionLine muss angepasst werden, wenn grafische Elemente verändert werden:
-    if (xOnlyCleanMeta == false) {
+    if (opt.xOnlyCleanMeta == false) {
         DefinitionLine defline;
         defline.ReadFromPugiNode(doc.child("definition"));
         defline.ReCalc(ElmtMinMax);
@@ -648,115 +1592,135 @@ void ProcessElement(pugi::xml_node doc) {
 
 
 /******************************************************************************/
-std::string ToSVG(pugi::xml_node node) {
-    std::string s = "";
-    s += "<svg xmlns=\"http://www.w3.org/2000/svg\"\n";
-    s += "     xmlns:xlink=\"http://www.w3.org/1999/xlink\"\n";
+void ToSVG(const ElementJob& job, pugi::xml_node node, SvgWriter& w) {
+    const ScaleOptions& opt = job.opt;
+    w << "<svg xmlns=\"http://www.w3.org/2000/svg\"\n";
+    w << "     xmlns:xlink=\"http://www.w3.org/1999/xlink\"\n";
     node = node.child("definition");
     // in der DefinitionLine stehen die Abmessungen drin:
     DefinitionLine DefLine;
     DefLine.ReadFromPugiNode(node);
     // Daten für Abmessungen aus Definition-Line:
-    s += "     width=\"" + std::to_string(DefLine.GetWidth());
-    s += "\" height=\"" + std::to_string(DefLine.GetHeight()) + "\">\n";
+    w << "     width=\"" << std::to_string(DefLine.GetWidth());
+    w << "\" height=\"" << std::to_string(DefLine.GetHeight()) << "\">\n";
+    // "--svg-classes" and "--svg-markers": the primitives first into a separate
+    // string - the collected classes and markers have to be in front of them
+    SvgClasses classes;
+    SvgMarkers markers;
+    std::string sPrimitives;
+    const bool xCollect = (opt.xSvgClasses || opt.xSvgMarkers);
+    if (xCollect) {
+        SvgWriter wp(sPrimitives);
+        if (opt.xSvgClasses) wp.UseClasses(&classes);
+        if (opt.xSvgMarkers) wp.UseMarkers(&markers);
+        PrimitivesToSVG(opt, node.child("description"), wp);
+        wp.Flush();
+    }
     // hier die Definition von "terminal", falls im Element vorhanden:
-    if (node.child("description").child("terminal")) {
-        s += "  <defs>\n";
-        s += "    <g id=\"terminal\" stroke-width=\"1\" stroke-linecap=\"square\">\n";
-        s += "      <line x1=\"0\" y1=\"0\" x2=\"0\" y2=\"4\" stroke=\"#0000FF\" />\n";
-        s += "      <line x1=\"0\" y1=\"1\" x2=\"0\" y2=\"4\" stroke=\"#FF0000\" />\n";
-        s += "    </g>\n";
-        s += "  </defs>\n";
+    const bool xTerminal = node.child("description").child("terminal");
+    if (xTerminal || (classes.Size() > 0) || (markers.Size() > 0)) {
+        w << "  <defs>\n";
+        if (classes.Size() > 0)
+            classes.WriteStyle(w);
+        markers.WriteDefs(w);
+        if (xTerminal) {
+            w << "    <g id=\"terminal\" stroke-width=\"1\" stroke-linecap=\"square\">\n";
+            w << "      <line x1=\"0\" y1=\"0\" x2=\"0\" y2=\"4\" stroke=\"#0000FF\" />\n";
+            w << "      <line x1=\"0\" y1=\"1\" x2=\"0\" y2=\"4\" stroke=\"#FF0000\" />\n";
+            w << "    </g>\n";
+        }
+        w << "  </defs>\n";
     }
     // dann weiter mit der Gruppierung der Elemente inklusive Verschiebung mit Daten aus Definition-Line:
     // da drin auch die allgemeingültige Anweisung für "stroke-linecap=(butt|round|square)" bei QET: square
-    s += "  <g transform=\"translate(" + std::to_string(DefLine.Gethotspot_x());
-    s += "," + std::to_string(DefLine.Gethotspot_y()) + ")\" stroke-linecap=\"square\">\n";
+    w << "  <g transform=\"translate("; w.Int(DefLine.Gethotspot_x());
+    w << ',';                           w.Int(DefLine.Gethotspot_y()) << ")\" stroke-linecap=\"square\">\n";
+    // Hier nun die grafischen Elemente:
+    if (xCollect)
+        w << sPrimitives;
+    else
+        PrimitivesToSVG(opt, node.child("description"), w);
+    // und nun noch die letzten schließenden Tags:
+    w << "  </g>\n  Your Browser does not support inline SVG!\n</svg>";
+}
+/******************************************************************************/
+
+
+
+/******************************************************************************/
+void PrimitivesToSVG(const ScaleOptions& opt, pugi::xml_node node, SvgWriter& w) {
     // Hier nun die Schleife für die grafischen Elemente
-    // edit the graphical elements of the QET-Element:
-    node = node.child("description").first_child();
+    node = node.first_child();
     // ... in a loop
     for (; node; node = node.next_sibling())
     {   //std::cout << ".";
-        if ((std::string(node.name())) == "rect") {
+        switch (LookupNodeKind(node.name())) {
+        case NodeKind::rect: {
             ElmtRect rect;
             rect.Clear();
             rect.ReadFromPugiNode(node);
-            s += "    "; s += rect.AsSVGstring(decimals); s += "\n";
+            w << "    "; rect.WriteSVG(w, opt.decimals); w << "\n";
+            break;
         }
-        if ((std::string(node.name())) == "text") {
+        case NodeKind::text: {
             ElmtText text;
             text.Clear();
             text.ReadFromPugiNode(node);
-            s += "    "; s += text.AsSVGstring(decimals); s += "\n";
+            w << "    "; text.WriteSVG(w, opt.decimals); w << "\n";
+            break;
         }
-        if ((std::string(node.name())) == "dynamic_text") {
+        case NodeKind::dynamic_text: {
             ElmtDynText dyntext;
             dyntext.Clear();
             dyntext.ReadFromPugiNode(node);
-            s += "    "; s += dyntext.AsSVGstring(decimals); s += "\n";
+            w << "    "; dyntext.WriteSVG(w, opt.decimals); w << "\n";
+            break;
         }
-        if (((std::string(node.name())) == "ellipse") || ((std::string(node.name())) == "circle")) {
+        case NodeKind::ellipse:
+        case NodeKind::circle: {
             ElmtEllipse elli;
             elli.Clear();
             elli.ReadFromPugiNode(node);
-            s += "    "; s += elli.AsSVGstring(decimals); s += "\n";
+            w << "    "; elli.WriteSVG(w, opt.decimals); w << "\n";
+            break;
         }
-        if ((std::string(node.name())) == "terminal") {
+        case NodeKind::terminal: {
             ElmtTerminal term;
             term.Clear();
             term.ReadFromPugiNode(node);
-            s += "    "; s += term.AsSVGstring(decimals); s += "\n";
+            w << "    "; term.WriteSVG(w, opt.decimals); w << "\n";
+            break;
         }
-        if ((std::string(node.name())) == "arc") {
+        case NodeKind::arc: {
             ElmtArc arc;
             arc.Clear();
             arc.ReadFromPugiNode(node);
-            s += "    "; s += arc.AsSVGstring(decimals); s += "\n";
+            w << "    "; arc.WriteSVG(w, opt.decimals); w << "\n";
+            break;
         }
-        if ((std::string(node.name())) == "polygon") {
+        case NodeKind::polygon: {
             ElmtPolygon pol;
             pol.Clear();
             if (pol.ReadFromPugiNode(node) == true) {
-                s += "    "; s += pol.AsSVGstring(decimals); s += "\n";
+                w << "    "; pol.WriteSVG(w, opt.decimals); w << "\n";
             } else {
-                s += "    INVALID Polygon in Element-File\n";
+                w << "    INVALID Polygon in Element-File\n";
             }
+            break;
         }
-        if ((std::string(node.name())) == "line") {
+        case NodeKind::line: {
             ElmtLine lin;
             lin.Clear();
             if (lin.ReadFromPugiNode(node) == true) {
-                s += "    "; s += lin.AsSVGstring(decimals); s += "\n";
+                w << "    "; lin.WriteSVG(w, opt.decimals); w << "\n";
             } else {
-                s += "    INVALID Line in Element-File\n";
+                w << "    INVALID Line in Element-File\n";
             }
+            break;
         }
-    }
-    // und nun noch die letzten schließenden Tags:
-    s += "  </g>\n  Your Browser does not support inline SVG!\n</svg>";
-    // FERTIG!
-    return s;
-}
-/******************************************************************************/
-
-
-
-/******************************************************************************/
-void ReplaceSubStrings(std::string& s){
-    // replace some substrings so that xml looks the same as with Qxml...
-    struct ErsatzText {
-        std::string sOld;
-        std::string sNew;
-    };
-    std::vector<ErsatzText> vsReplacements {
-            {{" />\n"},{"/>\n"}},
-            {{"<text/>"},{"<text></text>"}},
-    };
-    for (const ErsatzText &t: vsReplacements) {
-        //if (t.sOld.length()>4) std::cerr << "Texte: " << t.sOld << " | " << t.sNew << "\n";
-        while (s.find(t.sOld) != std::string::npos) {
-            s.replace(s.find(t.sOld), t.sOld.size(), t.sNew);
+        case NodeKind::input:
+        case NodeKind::other:
+            break;
         }
     }
 }